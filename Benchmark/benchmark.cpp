@@ -0,0 +1,728 @@
+/**
+ ********************************************
+ * @file    :benchmark.cpp
+ * @author  :XXY
+ * @brief   :Phase benchmarks on synthetic matrices
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+
+#include "SyntheticMatrix.hpp"
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "StreamingGraph.hpp"
+#include "IncrementalGraph.hpp"
+#include "MarkovClustering.hpp"
+#include "CommunityDetection.hpp"
+#include "Representatives.hpp"
+#include "Profiler.hpp"
+#include "OutputCompare.hpp"
+
+using namespace std;
+
+// ÷
+//     Benchmark [--sizes=1000,2000,5000,10000,20000,50000] [--engines=csr|graph,arena,csr,stream]
+//               [--max-memory-mb=<ڴ 75%>] [--clusters=20] [--singletons=0.05] [--intra=85,6] [--inter=35,5] [--seed=42]
+//               [--thresholds=50,70,90] [--min-neighbors=3] [--work-dir=benchmark_work]
+//               [--output=benchmark_results.tsv] [--memory-budget-mb=1024] [--keep-files] [--verbose]
+//               [--mcl[=ϵ]] [--communities[=ֱ]] [--representatives] [--reorder[=rcm|bfs]]
+//               [--profile[=benchmark_profile.json]]
+//     Benchmark --verify [--inputs=output_pim2.txt,...] [--golden=<Ŀ¼>] [--sizes=500,2000] ...
+//
+// ÿģһκϳɾȻÿʱ죨أvalidate_symmetry
+// perform_neighborhood_analysisget_connected_components Լȫ
+// д TSVÿһ (, ģ, ׶)ʱͽ׶νʱڴռá
+// ֵڴǽ̼ĵֵģСУÿеķֵý׶εռá
+// ָ --mcl ʱ csr ֧֮ͨʱ MCL ༰䵼
+// ָ --communities ʱ grapharenacsr ʱּ䵼
+// ָ --representatives ʱͬʱѡȡGraph Ҫ¶ȡԴ󣩣
+// ָ --reorder ʱ csr ڼ֦Žڵ㣬֮Ľ׶ζźͼϼʱ
+// ָ --profile ʱͬʱ ProfilerѸڲ׶μʱڴд JSON 
+// --verify ģʽͬã
+// Ĭֻ csr 档ÿ (, ģ) ǰÿֽڴ棬
+//  --max-memory-mb ˵һģ涼ʱҲɸùģľ
+//  Graph  2 ڵҪʮ GB ڴ棬csr  5 ڵʱԼ 50 GB
+//
+// --verify ģʽʱǰÿĸļοʵ Graph ĽһȽ
+// ˳ OutputCompare.hppΪ --inputs ľ͸ģĺϳɾ
+// ģʽֻȽ֧ͨǰ 3/4 ڵ㽨գ桢¼غ׷ڵС
+// ָ --golden ʱѵһĲοĿ¼±ĽȽϡвʱ 1
+
+struct BenchmarkOptions {
+    vector<size_t> sizes = { 1000, 2000, 5000, 10000, 20000, 50000 };
+    vector<string> engines = { "csr" };
+    size_t max_memory_mb = 0;        // 0 ʾڴ 75%
+    SyntheticMatrixOptions matrix;
+    double small_threshold = 50.0;
+    double medium_threshold = 70.0;
+    double large_threshold = 90.0;
+    size_t min_neighbors = 3;
+    size_t memory_budget_mb = 1024;  // stream ڴ
+    string work_dir = "benchmark_work";
+    string output_path = "benchmark_results.tsv";
+    bool keep_files = false;
+    bool verbose = false;
+    bool mcl = false;
+    MclOptions mcl_options;
+    bool communities = false;
+    CommunityOptions community_options;
+    bool representatives = false;
+    bool reorder = false;
+    NodeOrder node_order = NodeOrder::ReverseCuthillMcKee;
+
+    bool verify = false;
+    bool sizes_given = false;
+    vector<string> inputs;
+    string golden_dir;
+};
+
+struct PhaseResult {
+    string engine;
+    size_t nodes = 0;
+    string phase;
+    double seconds = 0.0;
+    double items = 0.0;
+    string unit;
+    size_t rss_bytes = 0;
+    size_t peak_rss_bytes = 0;
+};
+
+// Ŀ̨ģʱΪʱһ
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+class Benchmark {
+    BenchmarkOptions options_;
+    vector<PhaseResult> results_;
+    vector<string> skipped_;     // ڴ㳬޶˵
+    NullBuffer null_buffer_;
+
+    size_t estimated_bytes(const string& engine, size_t nodes) const;
+
+    PhaseResult& time_phase(const string& engine, size_t nodes, const string& phase,
+        double items, const string& unit, const function<void()>& body);
+    template <typename G>
+    void run_engine(const string& engine, size_t nodes, const string& matrix_path,
+        const function<G*(const string&)>& load);
+
+public:
+    explicit Benchmark(const BenchmarkOptions& options) : options_(options) {}
+
+    void run();
+    void print_results() const;
+    void export_results(const string& output_path) const;
+};
+
+// οʵһԼ
+class Verifier {
+    BenchmarkOptions options_;
+    NullBuffer null_buffer_;
+    size_t failures_ = 0;
+
+    template <typename G>
+    void write_outputs(G& graph, const string& dir) const;
+    void report(const string& input, const string& engine, const vector<FileComparison>& comparisons);
+    FileComparison compare_symmetry_reports(const string& matrix_path) const;
+    // Ѿǰ 3/4 ڵӾڵУIncrementalGraph::append_rows ʽ
+    void split_matrix(const string& matrix_path, const string& base_path, const string& rows_path) const;
+    void verify_input(const string& matrix_path, const string& name);
+
+public:
+    explicit Verifier(const BenchmarkOptions& options) : options_(options) {}
+
+    // زһµ (, ) 
+    size_t run();
+};
+
+/**************** Աʵ ****************/
+
+PhaseResult& Benchmark::time_phase(const string& engine, size_t nodes, const string& phase,
+    double items, const string& unit, const function<void()>& body) {
+    streambuf* console = cout.rdbuf();
+    if (!options_.verbose) cout.rdbuf(&null_buffer_);
+
+    const auto start = chrono::steady_clock::now();
+    try {
+        body();
+    }
+    catch (...) {
+        cout.rdbuf(console);
+        throw;
+    }
+    const auto stop = chrono::steady_clock::now();
+    cout.rdbuf(console);
+
+    PhaseResult result;
+    result.engine = engine;
+    result.nodes = nodes;
+    result.phase = phase;
+    result.seconds = chrono::duration<double>(stop - start).count();
+    result.items = items;
+    result.unit = unit;
+    result.rss_bytes = Profiler::current_rss_bytes();
+    result.peak_rss_bytes = Profiler::peak_rss_bytes();
+    results_.push_back(result);
+
+    cout << "  " << left << setw(8) << engine << setw(60) << phase << right
+        << fixed << setprecision(3) << setw(10) << result.seconds << " s"
+        << setw(10) << result.rss_bytes / (1024 * 1024) << " MB" << defaultfloat << endl;
+    return results_.back();
+}
+
+template <typename G>
+void Benchmark::run_engine(const string& engine, size_t nodes, const string& matrix_path,
+    const function<G*(const string&)>& load) {
+    const double cells = static_cast<double>(nodes) * nodes;
+    const double pairs = static_cast<double>(nodes) * (nodes - 1) / 2;
+    const string prefix = (filesystem::path(options_.work_dir) / (engine + "_" + to_string(nodes) + "_")).string();
+
+    unique_ptr<G> graph;
+    time_phase(engine, nodes, "load", cells, "cells", [&] { graph.reset(load(matrix_path)); });
+    time_phase(engine, nodes, "validate_symmetry", pairs, "pairs", [&] { graph->validate_symmetry(); });
+    time_phase(engine, nodes, "perform_neighborhood_analysis", pairs, "pairs", [&] {
+        graph->perform_neighborhood_analysis(options_.small_threshold, options_.medium_threshold,
+            options_.large_threshold, options_.min_neighbors);
+    });
+    if constexpr (is_same<G, CsrGraph>::value) {
+        if (options_.reorder) {
+            time_phase(engine, nodes, "reorder", static_cast<double>(nodes), "nodes", [&] {
+                graph->reorder(options_.node_order);
+            });
+        }
+    }
+    time_phase(engine, nodes, "get_connected_components", static_cast<double>(nodes), "nodes", [&] {
+        graph->get_connected_components();
+    });
+    if constexpr (is_same<G, CsrGraph>::value) {
+        if (options_.mcl) {
+            unique_ptr<MarkovClustering> mcl;
+            time_phase(engine, nodes, "markov_clustering", static_cast<double>(nodes), "nodes", [&] {
+                mcl.reset(new MarkovClustering(*graph, options_.mcl_options));
+                mcl->run();
+            });
+            const string path = prefix + "mcl_clusters.txt";
+            PhaseResult& result = time_phase(engine, nodes, "export_clusters_to_single_file", 0.0, "bytes", [&] {
+                mcl->export_clusters_to_single_file(path);
+            });
+            result.items = static_cast<double>(filesystem::file_size(path));
+            if (!options_.keep_files) filesystem::remove(path);
+        }
+    }
+    if constexpr (!is_same<G, StreamingGraph>::value) {
+        if (options_.communities) {
+            unique_ptr<CommunityDetector> detector;
+            time_phase(engine, nodes, "detect_communities", static_cast<double>(nodes), "nodes", [&] {
+                detector.reset(new CommunityDetector(*graph, options_.community_options));
+                detector->run();
+            });
+            const string path = prefix + "all_communities.txt";
+            PhaseResult& result = time_phase(engine, nodes, "export_communities_to_single_file", 0.0, "bytes", [&] {
+                detector->export_communities_to_single_file(path);
+            });
+            result.items = static_cast<double>(filesystem::file_size(path));
+            if (!options_.keep_files) filesystem::remove(path);
+        }
+        if (options_.representatives) {
+            unique_ptr<RepresentativeSelector> selector;
+            time_phase(engine, nodes, "select_representatives", static_cast<double>(nodes), "nodes", [&] {
+                if constexpr (is_same<G, CsrGraph>::value) {
+                    if (graph->has_original_weights()) selector.reset(new RepresentativeSelector(*graph));
+                    else selector.reset(new RepresentativeSelector(*graph, matrix_path));
+                }
+                else {
+                    selector.reset(new RepresentativeSelector(*graph, matrix_path));
+                }
+                selector->run();
+            });
+            const string path = prefix + "representatives.tsv";
+            PhaseResult& result = time_phase(engine, nodes, "export_representatives_tsv", 0.0, "bytes", [&] {
+                selector->export_representatives_tsv(path);
+            });
+            result.items = static_cast<double>(filesystem::file_size(path));
+            if (!options_.keep_files) filesystem::remove(path);
+        }
+    }
+
+    // ׶дֽ
+    auto export_phase = [&](const string& phase, const string& path, const function<void()>& body) {
+        PhaseResult& result = time_phase(engine, nodes, phase, 0.0, "bytes", body);
+        result.items = static_cast<double>(filesystem::file_size(path));
+        if (!options_.keep_files) filesystem::remove(path);
+    };
+    export_phase("export_adjacency_matrix", prefix + "adjacency_matrix.txt", [&] {
+        graph->export_adjacency_matrix(prefix + "adjacency_matrix.txt");
+    });
+    export_phase("export_all_components_to_single_file", prefix + "all_components.txt", [&] {
+        graph->export_all_components_to_single_file(prefix + "all_components.txt");
+    });
+    export_phase("export_edge_list_for_cytoscape", prefix + "network_for_cytoscape.txt", [&] {
+        graph->export_edge_list_for_cytoscape(prefix + "network_for_cytoscape.txt", "similarity_link");
+    });
+    export_phase("export_all_component_adjacency_matrices_to_single_file",
+        prefix + "all_component_adjacency_matrices.txt", [&] {
+        graph->export_all_component_adjacency_matrices_to_single_file(prefix + "all_component_adjacency_matrices.txt");
+    });
+
+    time_phase(engine, nodes, "destroy", static_cast<double>(nodes), "nodes", [&] { graph.reset(); });
+}
+
+static size_t physical_memory_bytes() {
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) return static_cast<size_t>(status.ullTotalPhys);
+    return 0;
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long page_size = sysconf(_SC_PAGESIZE);
+    return pages > 0 && page_size > 0 ? static_cast<size_t>(pages) * static_cast<size_t>(page_size) : 0;
+#endif
+}
+
+// ÿߵֽ 1500 ڵʱʵķֵڴõʱʱռãÿڵԼ 1 KB
+// stream  --memory-budget-mb ƣͬģ csr 
+size_t Benchmark::estimated_bytes(const string& engine, size_t nodes) const {
+    const double edges = static_cast<double>(nodes) * (nodes > 0 ? nodes - 1 : 0);
+    const double per_node = 1024.0 * nodes;
+    double bytes = 0.0;
+    if (engine == "graph") bytes = 80.0 * edges;
+    else if (engine == "arena") bytes = 72.0 * edges;
+    else if (engine == "csr") bytes = 20.0 * edges;
+    else if (engine == "stream") bytes = min(20.0 * edges, options_.memory_budget_mb * 1024.0 * 1024.0);
+    return static_cast<size_t>(bytes + per_node);
+}
+
+void Benchmark::run() {
+    filesystem::create_directories(options_.work_dir);
+
+    size_t limit = options_.max_memory_mb * 1024 * 1024;
+    if (limit == 0) limit = physical_memory_bytes() / 4 * 3;
+    if (limit > 0) cout << "ڴ: " << limit / (1024 * 1024) << " MB" << endl;
+
+    for (size_t nodes : options_.sizes) {
+        vector<string> engines;
+        for (const string& engine : options_.engines) {
+            const size_t need = estimated_bytes(engine, nodes);
+            if (limit > 0 && need > limit) {
+                ostringstream note;
+                note << engine << " @ " << nodes << " ڵ: Ҫ " << need / (1024 * 1024)
+                    << " MB " << limit / (1024 * 1024) << " MB";
+                cout << " " << note.str() << endl;
+                skipped_.push_back(note.str());
+                continue;
+            }
+            engines.push_back(engine);
+        }
+        if (engines.empty()) continue;
+
+        SyntheticMatrixOptions matrix_options = options_.matrix;
+        matrix_options.nodes = nodes;
+        const SyntheticMatrix matrix(matrix_options);
+        const string matrix_path = (filesystem::path(options_.work_dir) / ("synthetic_" + to_string(nodes) + ".txt")).string();
+
+        cout << "ģ " << nodes << " ڵ:" << endl;
+        PhaseResult& generated = time_phase("gen", nodes, "generate", 0.0, "bytes", [&] {
+            matrix.write(matrix_path);
+        });
+        generated.items = static_cast<double>(filesystem::file_size(matrix_path));
+
+        for (const string& engine : engines) {
+            if (engine == "graph") {
+                run_engine<Graph>(engine, nodes, matrix_path, [](const string& path) { return new Graph(path); });
+            }
+            else if (engine == "arena") {
+                run_engine<Graph>(engine, nodes, matrix_path, [](const string& path) { return new Graph(path, true); });
+            }
+            else if (engine == "csr") {
+                run_engine<CsrGraph>(engine, nodes, matrix_path, [](const string& path) { return new CsrGraph(path); });
+            }
+            else if (engine == "stream") {
+                StreamingOptions stream_options;
+                stream_options.memory_budget_mb = options_.memory_budget_mb;
+                stream_options.temp_dir = options_.work_dir;
+                run_engine<StreamingGraph>(engine, nodes, matrix_path, [&](const string& path) {
+                    return new StreamingGraph(path, stream_options);
+                });
+            }
+            else {
+                throw invalid_argument("δ֪: " + engine);
+            }
+        }
+
+        if (!options_.keep_files) filesystem::remove(matrix_path);
+    }
+}
+
+void Benchmark::print_results() const {
+    cout << "\n:\n";
+    for (const auto& r : results_) {
+        const double rate = r.seconds > 0 ? r.items / r.seconds : 0.0;
+        cout << "  " << left << setw(8) << r.engine << setw(8) << r.nodes << setw(60) << r.phase << right;
+        if (r.unit == "bytes") cout << fixed << setprecision(1) << setw(12) << rate / (1024 * 1024) << " MB/s";
+        else cout << scientific << setprecision(3) << setw(12) << rate << " " << r.unit << "/s";
+        cout << defaultfloat << "\n";
+    }
+    cout << "  ֵڴ: " << Profiler::peak_rss_bytes() / (1024 * 1024) << " MB" << endl;
+    if (!skipped_.empty()) {
+        cout << "ڴ㳬:\n";
+        for (const string& note : skipped_) cout << "  " << note << "\n";
+    }
+}
+
+void Benchmark::export_results(const string& output_path) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "engine\tnodes\tphase\tseconds\titems\tunit\titems_per_second\trss_mb\tpeak_rss_mb\n";
+    for (const auto& r : results_) {
+        outfile << r.engine << "\t" << r.nodes << "\t" << r.phase << "\t" << r.seconds << "\t"
+            << static_cast<unsigned long long>(r.items) << "\t" << r.unit << "\t"
+            << (r.seconds > 0 ? r.items / r.seconds : 0.0) << "\t"
+            << r.rss_bytes / (1024.0 * 1024.0) << "\t" << r.peak_rss_bytes / (1024.0 * 1024.0) << "\n";
+    }
+
+    outfile.close();
+    cout << "׼Խѵ: " << output_path << endl;
+}
+
+template <typename G>
+void Verifier::write_outputs(G& graph, const string& dir) const {
+    filesystem::create_directories(dir);
+    graph.validate_symmetry();
+    graph.perform_neighborhood_analysis(options_.small_threshold, options_.medium_threshold,
+        options_.large_threshold, options_.min_neighbors);
+    graph.export_adjacency_matrix(dir + "/adjacency_matrix.txt");
+    graph.export_all_components_to_single_file(dir + "/all_components.txt");
+    graph.export_edge_list_for_cytoscape(dir + "/network_for_cytoscape.txt", "similarity_link");
+    graph.export_all_component_adjacency_matrices_to_single_file(dir + "/all_component_adjacency_matrices.txt");
+}
+
+void Verifier::report(const string& input, const string& engine, const vector<FileComparison>& comparisons) {
+    const bool equal = OutputComparer::all_equal(comparisons);
+    cout << "  " << input << " / " << engine << ": " << (equal ? "һ" : "һ") << "\n";
+    if (!equal) {
+        OutputComparer::print(comparisons);
+        ++failures_;
+    }
+}
+
+// 벢еĶԳԼ飨ռģʽͬı
+FileComparison Verifier::compare_symmetry_reports(const string& matrix_path) const {
+    FileComparison result;
+    result.file = "check_symmetry";
+
+    CsrGraph graph(matrix_path);
+    SymmetryCheckOptions check;
+    check.stop_at_first = false;
+    check.threads = 1;
+    const SymmetryReport serial = graph.check_symmetry(check);
+    check.threads = 0;
+    const SymmetryReport parallel = graph.check_symmetry(check);
+
+    if (serial.checked_pairs != parallel.checked_pairs || serial.violation_count != parallel.violation_count ||
+        serial.violations.size() != parallel.violations.size()) {
+        result.equal = false;
+        result.differences = 1;
+        result.details.push_back(": " + to_string(serial.violation_count) + " Գƣ: " +
+            to_string(parallel.violation_count) + " ");
+        return result;
+    }
+    for (size_t k = 0; k < serial.violations.size(); ++k) {
+        const SymmetryViolation& a = serial.violations[k];
+        const SymmetryViolation& b = parallel.violations[k];
+        if (a.row != b.row || a.col != b.col) {
+            result.equal = false;
+            ++result.differences;
+            if (result.details.size() < OutputComparer::kMaxDetails) {
+                result.details.push_back(" " + to_string(k + 1) + " Υλòͬ");
+            }
+        }
+    }
+    return result;
+}
+
+void Verifier::split_matrix(const string& matrix_path, const string& base_path, const string& rows_path) const {
+    MatrixInputStream file(matrix_path);
+    if (!file) throw runtime_error("޷ļ: " + matrix_path);
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) throw runtime_error("ļΪ");
+    const vector<string> ids(reader.tokens().begin(), reader.tokens().end());
+    const size_t n = ids.size();
+    const size_t base_count = n - n / 4;
+
+    ofstream base(base_path, ios::binary);
+    ofstream rows(rows_path, ios::binary);
+    if (!base.is_open()) throw runtime_error("޷ļ: " + base_path);
+    if (!rows.is_open()) throw runtime_error("޷ļ: " + rows_path);
+
+    string line;
+    for (size_t j = 0; j < n; ++j) {
+        if (j == base_count) base << line << '\n';
+        line += '\t';
+        line += ids[j];
+    }
+    if (base_count == n) base << line << '\n';
+    rows << line << '\n';
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!reader.next_row() || reader.size() != n + 1) {
+            throw runtime_error("" + to_string(i + 1) + "ݲ");
+        }
+        const size_t columns = i < base_count ? base_count : n;
+        line.assign(reader[0]);
+        for (size_t j = 1; j <= columns; ++j) {
+            line += '\t';
+            line += reader[j];
+        }
+        line += '\n';
+        (i < base_count ? base : rows) << line;
+    }
+}
+
+void Verifier::verify_input(const string& matrix_path, const string& name) {
+    const string base = (filesystem::path(options_.work_dir) / ("verify_" + name)).string();
+    const string reference = base + "/graph";
+
+    streambuf* console = cout.rdbuf();
+    auto quiet = [&] { if (!options_.verbose) cout.rdbuf(&null_buffer_); };
+    auto loud = [&] { cout.rdbuf(console); };
+
+    try {
+        quiet();
+        {
+            Graph graph(matrix_path);
+            write_outputs(graph, reference);
+        }
+        loud();
+
+        if (!options_.golden_dir.empty() && name == "input_1") {
+            report(name, "golden", OutputComparer::compare_directories(options_.golden_dir, reference));
+        }
+
+        quiet();
+        {
+            Graph graph(matrix_path, true);
+            write_outputs(graph, base + "/arena");
+        }
+        loud();
+        report(name, "arena", OutputComparer::compare_directories(reference, base + "/arena"));
+
+        quiet();
+        {
+            CsrGraph graph(matrix_path);
+            write_outputs(graph, base + "/csr");
+        }
+        loud();
+        report(name, "csr", OutputComparer::compare_directories(reference, base + "/csr"));
+
+        // ֦ѹ洢ٵӦı
+        quiet();
+        {
+            CsrGraph graph(matrix_path);
+            graph.validate_symmetry();
+            graph.perform_neighborhood_analysis(options_.small_threshold, options_.medium_threshold,
+                options_.large_threshold, options_.min_neighbors);
+            graph.compact();
+            const string dir = base + "/csr_compact";
+            filesystem::create_directories(dir);
+            graph.export_adjacency_matrix(dir + "/adjacency_matrix.txt");
+            graph.export_all_components_to_single_file(dir + "/all_components.txt");
+            graph.export_edge_list_for_cytoscape(dir + "/network_for_cytoscape.txt", "similarity_link");
+            graph.export_all_component_adjacency_matrices_to_single_file(dir + "/all_component_adjacency_matrices.txt");
+        }
+        loud();
+        report(name, "csr_compact", OutputComparer::compare_directories(reference, base + "/csr_compact"));
+
+        // ź˳򵼳Ӧδʱֽͬ
+        quiet();
+        {
+            CsrGraph graph(matrix_path);
+            graph.validate_symmetry();
+            graph.perform_neighborhood_analysis(options_.small_threshold, options_.medium_threshold,
+                options_.large_threshold, options_.min_neighbors);
+            graph.reorder(NodeOrder::ReverseCuthillMcKee);
+            graph.set_original_order_output(true);
+            const string dir = base + "/csr_reorder";
+            filesystem::create_directories(dir);
+            graph.export_adjacency_matrix(dir + "/adjacency_matrix.txt");
+            graph.export_all_components_to_single_file(dir + "/all_components.txt");
+            graph.export_edge_list_for_cytoscape(dir + "/network_for_cytoscape.txt", "similarity_link");
+            graph.export_all_component_adjacency_matrices_to_single_file(dir + "/all_component_adjacency_matrices.txt");
+        }
+        loud();
+        report(name, "csr_reorder", OutputComparer::compare_directories(reference, base + "/csr_reorder"));
+
+        // ģʽʹ 1 MB ޣ֤߻дɶβ鲢
+        quiet();
+        {
+            StreamingOptions stream_options;
+            stream_options.memory_budget_mb = 1;
+            stream_options.temp_dir = options_.work_dir;
+            StreamingGraph graph(matrix_path, stream_options);
+            write_outputs(graph, base + "/stream");
+        }
+        loud();
+        report(name, "stream", OutputComparer::compare_directories(reference, base + "/stream"));
+
+        // ģʽǰ 3/4 ڵ㽨գ沢¼غ׷У֧ͨӦͷͬ
+        quiet();
+        {
+            const string dir = base + "/incremental";
+            filesystem::create_directories(dir);
+            split_matrix(matrix_path, dir + "/base.txt", dir + "/rows.txt");
+            IncrementalGraph initial(dir + "/base.txt", options_.small_threshold, options_.medium_threshold,
+                options_.large_threshold, options_.min_neighbors);
+            initial.save_snapshot(dir + "/snapshot.bin");
+            IncrementalGraph graph = IncrementalGraph::load_snapshot(dir + "/snapshot.bin");
+            graph.append_rows(dir + "/rows.txt");
+            graph.export_all_components_to_single_file(dir + "/all_components.txt");
+        }
+        loud();
+        report(name, "incremental", { OutputComparer::compare_components(reference + "/all_components.txt",
+            base + "/incremental/all_components.txt") });
+
+        quiet();
+        const FileComparison symmetry = compare_symmetry_reports(matrix_path);
+        loud();
+        report(name, "csr_serial_parallel", { symmetry });
+    }
+    catch (...) {
+        loud();
+        throw;
+    }
+
+    if (!options_.keep_files) filesystem::remove_all(base);
+}
+
+size_t Verifier::run() {
+    filesystem::create_directories(options_.work_dir);
+    cout << "һԼ飨οʵ: Graph:\n";
+
+    for (size_t i = 0; i < options_.inputs.size(); ++i) {
+        cout << " " << options_.inputs[i] << "\n";
+        verify_input(options_.inputs[i], "input_" + to_string(i + 1));
+    }
+
+    for (size_t nodes : options_.sizes) {
+        SyntheticMatrixOptions matrix_options = options_.matrix;
+        matrix_options.nodes = nodes;
+        const string matrix_path = (filesystem::path(options_.work_dir) / ("synthetic_" + to_string(nodes) + ".txt")).string();
+        SyntheticMatrix(matrix_options).write(matrix_path);
+        cout << "ϳɾ " << nodes << " ڵ\n";
+        verify_input(matrix_path, "synthetic_" + to_string(nodes));
+        if (!options_.keep_files) filesystem::remove(matrix_path);
+    }
+
+    cout << (failures_ ? " " + to_string(failures_) + " һ" : string("ȫһ")) << endl;
+    return failures_;
+}
+
+static vector<string> split_list(const string& value) {
+    vector<string> items;
+    stringstream ss(value);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+static BenchmarkOptions parse_arguments(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const string key = arg.substr(0, eq);
+        const string value = eq == string::npos ? "" : arg.substr(eq + 1);
+        const vector<string> list = split_list(value);
+
+        if (key == "--sizes") {
+            options.sizes.clear();
+            for (const auto& s : list) options.sizes.push_back(stoul(s));
+            options.sizes_given = true;
+        }
+        else if (key == "--engines") options.engines = list;
+        else if (key == "--max-memory-mb") options.max_memory_mb = stoul(value);
+        else if (key == "--clusters") options.matrix.clusters = stoul(value);
+        else if (key == "--singletons") options.matrix.singleton_fraction = stod(value);
+        else if (key == "--intra" && list.size() == 2) {
+            options.matrix.intra_mean = stod(list[0]);
+            options.matrix.intra_stddev = stod(list[1]);
+        }
+        else if (key == "--inter" && list.size() == 2) {
+            options.matrix.inter_mean = stod(list[0]);
+            options.matrix.inter_stddev = stod(list[1]);
+        }
+        else if (key == "--seed") options.matrix.seed = stoull(value);
+        else if (key == "--thresholds" && list.size() == 3) {
+            options.small_threshold = stod(list[0]);
+            options.medium_threshold = stod(list[1]);
+            options.large_threshold = stod(list[2]);
+        }
+        else if (key == "--min-neighbors") options.min_neighbors = stoul(value);
+        else if (key == "--memory-budget-mb") options.memory_budget_mb = stoul(value);
+        else if (key == "--work-dir") options.work_dir = value;
+        else if (key == "--output") options.output_path = value;
+        else if (key == "--keep-files") options.keep_files = true;
+        else if (key == "--verbose") options.verbose = true;
+        else if (key == "--mcl") {
+            options.mcl = true;
+            if (!value.empty()) options.mcl_options.inflation = stod(value);
+        }
+        else if (key == "--representatives") options.representatives = true;
+        else if (key == "--reorder") {
+            options.reorder = true;
+            if (value == "bfs") options.node_order = NodeOrder::Bfs;
+            else if (!value.empty() && value != "rcm") throw invalid_argument("δ֪ŷʽ: " + value);
+        }
+        else if (key == "--communities") {
+            options.communities = true;
+            if (!value.empty()) options.community_options.resolution = stod(value);
+        }
+        else if (key == "--verify") options.verify = true;
+        else if (key == "--inputs") options.inputs = list;
+        else if (key == "--golden") options.golden_dir = value;
+        else throw invalid_argument("޷ʶĲ: " + arg);
+    }
+    if (options.verify && !options.sizes_given) options.sizes = { 500, 2000 };
+    if (options.sizes.empty() && !options.verify) throw invalid_argument("Ҫһģ");
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        const string profile_path = Profiler::instance().consume_flag(argc, argv, "benchmark_profile.json");
+        const BenchmarkOptions options = parse_arguments(argc, argv);
+        if (options.verify) {
+            const int status = Verifier(options).run() == 0 ? 0 : 1;
+            if (!profile_path.empty()) Profiler::instance().write_report(profile_path);
+            return status;
+        }
+        Benchmark benchmark(options);
+        benchmark.run();
+        benchmark.print_results();
+        benchmark.export_results(options.output_path);
+        if (!profile_path.empty()) Profiler::instance().write_report(profile_path);
+    }
+    catch (const exception& e) {
+        cerr << ": " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
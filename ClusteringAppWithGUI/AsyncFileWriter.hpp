@@ -0,0 +1,245 @@
+/**
+ ********************************************
+ * @file    :AsyncFileWriter.hpp
+ * @author  :XXY
+ * @brief   :Buffered output stream with a background I/O thread for exporters
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_ASYNC_FILE_WRITER_HPP
+#define LSPQ_ASYNC_FILE_WRITER_HPP
+
+#include <iostream>
+#include <ostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+// õ첽д壺ֻ߳ʽڴ滺дĻ̨߳д̣
+// ͬʱһлʽ̨дڸʽʱ߳ȡлȴ
+//
+// ļд <Ŀ>.partclose() ɹٸΪĿļ;׳쳣ʱ
+// °صĽļԭеͬļҲֲ䡣
+// ײļԶƴ򿪲ر filebuf Ļ壬ÿһд
+// Windows ں̨߳а \n תΪ \r\nԭıģʽ ofstream ֽͬ
+class AsyncFileBuf : public streambuf {
+    static constexpr size_t kBufferBytes = size_t(1) << 20;
+    static constexpr size_t kBufferCount = 3;
+
+    string path_;
+    string temp_path_;
+    ofstream file_;
+    vector<vector<char>> buffers_;
+    size_t current_ = 0;
+    BoundedQueue<pair<size_t, size_t>> filled_;  // (, ֽ)
+    BoundedQueue<size_t> free_;
+    thread io_thread_;
+    atomic<bool> failed_{ false };
+    size_t bytes_written_ = 0;                   // ɺ̨߳޸ģclose() Ϻȡ
+    bool open_ = false;
+    chrono::steady_clock::time_point start_;
+    double seconds_ = 0.0;
+
+    // ˽й߷
+    bool submit();
+    void io_loop();
+    void abandon();
+
+protected:
+    int_type overflow(int_type ch) override;
+    streamsize xsputn(const char* s, streamsize n) override;
+    int sync() override { return 0; } // д close() ʱŽendl д
+
+public:
+    AsyncFileBuf() : filled_(kBufferCount), free_(kBufferCount) {}
+    ~AsyncFileBuf();
+    AsyncFileBuf(const AsyncFileBuf&) = delete;
+    AsyncFileBuf& operator=(const AsyncFileBuf&) = delete;
+
+    bool open(const string& path);
+    bool is_open() const { return open_; }
+    // дʣݲΪĿļκһʧܶɾʱļ false
+    bool close();
+
+    size_t bytes_written() const { return bytes_written_; }
+    double seconds() const { return seconds_; }
+};
+
+//  ofstream ÷ͬʱ򿪣is_open() 飬close() д̲дٶȡ
+// close() ʧʱ׳쳣δ close() 絼׳쳣ʱʱļ
+class AsyncFileWriter : public ostream {
+    AsyncFileBuf buffer_;
+    string path_;
+
+public:
+    explicit AsyncFileWriter(const string& path);
+
+    bool is_open() const { return buffer_.is_open(); }
+    void close();
+
+    size_t bytes_written() const { return buffer_.bytes_written(); }
+    double seconds() const { return buffer_.seconds(); }
+};
+
+/**************** Աʵ ****************/
+
+AsyncFileBuf::~AsyncFileBuf() {
+    if (open_) abandon();
+}
+
+//  close() ʱرգÿֻܴһ
+bool AsyncFileBuf::open(const string& path) {
+    if (open_ || !temp_path_.empty()) return false;
+    path_ = path;
+    temp_path_ = path + ".part";
+    file_.rdbuf()->pubsetbuf(nullptr, 0);
+    file_.open(temp_path_, ios::binary | ios::trunc);
+    if (!file_.is_open()) return false;
+
+    buffers_.assign(kBufferCount, vector<char>(kBufferBytes));
+    for (size_t i = 1; i < kBufferCount; ++i) free_.push(i);
+    current_ = 0;
+    setp(buffers_[0].data(), buffers_[0].data() + kBufferBytes);
+    failed_ = false;
+    bytes_written_ = 0;
+    start_ = chrono::steady_clock::now();
+    io_thread_ = thread(&AsyncFileBuf::io_loop, this);
+    open_ = true;
+    return true;
+}
+
+// ǰһл̨߳ѳʱ falseд֮ʧ
+bool AsyncFileBuf::submit() {
+    const size_t used = static_cast<size_t>(pptr() - pbase());
+    if (used > 0) {
+        filled_.push({ current_, used });
+        free_.pop(current_);
+        setp(buffers_[current_].data(), buffers_[current_].data() + kBufferBytes);
+    }
+    return !failed_;
+}
+
+void AsyncFileBuf::io_loop() {
+    pair<size_t, size_t> item;
+#ifdef _WIN32
+    vector<char> translated;
+#endif
+    while (filled_.pop(item)) {
+        const char* data = buffers_[item.first].data();
+        size_t size = item.second;
+#ifdef _WIN32
+        translated.clear();
+        for (size_t i = 0; i < size; ++i) {
+            if (data[i] == '\n') translated.push_back('\r');
+            translated.push_back(data[i]);
+        }
+        data = translated.data();
+        size = translated.size();
+#endif
+        if (!failed_) {
+            file_.write(data, static_cast<streamsize>(size));
+            if (file_) bytes_written_ += size;
+            else failed_ = true;
+        }
+        free_.push(item.first);
+    }
+}
+
+AsyncFileBuf::int_type AsyncFileBuf::overflow(int_type ch) {
+    if (!open_ || !submit()) return traits_type::eof();
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+// д루ԤȸʽõľУֱӷֶο뻺ַ overflow
+streamsize AsyncFileBuf::xsputn(const char* s, streamsize n) {
+    if (!open_) return 0;
+    streamsize done = 0;
+    while (done < n) {
+        if (pptr() == epptr() && !submit()) break;
+        const size_t room = static_cast<size_t>(epptr() - pptr());
+        const size_t chunk = min(room, static_cast<size_t>(n - done));
+        memcpy(pptr(), s + done, chunk);
+        pbump(static_cast<int>(chunk));
+        done += static_cast<streamsize>(chunk);
+    }
+    return done;
+}
+
+bool AsyncFileBuf::close() {
+    if (!open_) return false;
+    submit();
+    filled_.close();
+    io_thread_.join();
+    open_ = false;
+    setp(nullptr, nullptr);
+    file_.close();
+    seconds_ = chrono::duration<double>(chrono::steady_clock::now() - start_).count();
+
+    error_code ec;
+    if (failed_ || file_.fail()) {
+        filesystem::remove(temp_path_, ec);
+        return false;
+    }
+    filesystem::rename(temp_path_, path_, ec);
+    if (ec) {
+        filesystem::remove(temp_path_, ec);
+        return false;
+    }
+    LSPQ_PROFILE_COUNT("AsyncFileWriter::bytes", bytes_written_);
+    return true;
+}
+
+// д룺ֹ̨̲ͣ߳ɾʱļĿļӰ
+void AsyncFileBuf::abandon() {
+    failed_ = true;
+    filled_.close();
+    free_.close();
+    io_thread_.join();
+    open_ = false;
+    setp(nullptr, nullptr);
+    file_.close();
+    error_code ec;
+    filesystem::remove(temp_path_, ec);
+}
+
+AsyncFileWriter::AsyncFileWriter(const string& path) : ostream(nullptr), path_(path) {
+    if (buffer_.open(path)) rdbuf(&buffer_);
+}
+
+void AsyncFileWriter::close() {
+    if (!buffer_.is_open()) return;
+    if (!buffer_.close()) {
+        setstate(ios::badbit);
+        throw runtime_error("дļʧ: " + path_);
+    }
+    //  fixed ҵ ios_base::fixed ־λǲݷֱøʽ
+    ostringstream report;
+    report.setf(ios::fixed, ios::floatfield);
+    const double mb = buffer_.bytes_written() / (1024.0 * 1024.0);
+    report << "д " << setprecision(2) << mb << " MBʱ " << setprecision(3)
+        << buffer_.seconds() << " s";
+    if (buffer_.seconds() > 0.0) report << "" << setprecision(1) << mb / buffer_.seconds() << " MB/s";
+    cout << report.str() << endl;
+}
+
+#endif // LSPQ_ASYNC_FILE_WRITER_HPP
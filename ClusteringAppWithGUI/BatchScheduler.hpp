@@ -0,0 +1,480 @@
+/**
+ ********************************************
+ * @file    :BatchScheduler.hpp
+ * @author  :XXY
+ * @brief   :Batch mode: many matrices and parameter sets in one backend run
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_BATCH_SCHEDULER_HPP
+#define LSPQ_BATCH_SCHEDULER_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_set>
+
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "CsrGraph.hpp"
+#include "StreamingGraph.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+
+using namespace std;
+
+struct BatchOptions {
+    string output_root = "batch_output"; // ÿҵ½ԼĿ¼
+    size_t memory_budget_mb = 4096;      // вҵڴ֮͵
+    size_t threads = 0;                  // Ĺ߳0 ʾȫӲ߳
+};
+
+// 嵥еһУһļһͬһļԳֶΣʹòͬ
+struct BatchJob {
+    size_t line = 0;             // 嵥екţڱ
+    string name;                 // ҵҲĿ¼
+    string input;
+    double small_threshold = 0.0;
+    double medium_threshold = 0.0;
+    double large_threshold = 0.0;
+    size_t min_neighbors = 0;
+
+    // ƻ׶д
+    size_t nodes = 0;
+    string engine;               // "csr"ڴڣ"stream"㳬Ԥʱģʽ
+    size_t estimated_bytes = 0;
+    string output_dir;
+
+    // ִн׶д
+    size_t threads = 0;          // ȫռõ߳
+    size_t symmetry_threads = 0; // csr ҵԳԼʵʹõ߳ã
+    bool succeeded = false;
+    string message;
+    double seconds = 0.0;
+    size_t components = 0;
+};
+
+// һκ˵ô
+//
+// 嵥ΪƱָıÿУ
+//     ļ  Сֵ  ֵ  ֵ  ھ  [ҵ]
+// 뵥ļģʽλò˳һ£ȥĿ¼к # ͷкԡ
+// ҵȱʡʱȡļչʱ _2_3 δʹõĺ׺
+//
+// ȣڴӴСŶӣҵĹڴ֮ͲԤ㣻׷Ųʱ
+// ӺܷµСҵܣСᱻִС
+// ֻ߳ҵʵϵռãCsrGraph ֻжԳԼǲеģcsr ҵȫֻռ 1 ̣߳
+// ԳԼڼٴӿ߳ʱã黹StreamingGraph Ľ֦ȫ̲У
+// stream ҵõ߳ıռҵı 1 Ϊǰ
+// ҵŶʱһcsr ҵõ߳Ҳͬһ㡣
+// ҵ㳬Ԥʱ StreamingGraphԤΪڴ޲ռִС
+//
+// ҵд output_root/ҵ/ £ļ뵥ļģʽͬcsr ҵ
+// graph_statistics.tsv / .jsonStreamingGraph άͳϢҵڼӡ
+// cout ض򵽸Ŀ¼µ log.txtֻ̨ʾȽȡĳҵʧܲӰҵ
+// Ϣд output_root/batch_summary.tsv
+class BatchScheduler {
+    //  cout ̷߳Ǽǹ߳дԵ־߳дԭĿ̨
+    // 軺ÿд붼 xsputn/overflowֻп̨һҪ
+    class ThreadRoutingBuffer : public streambuf {
+        streambuf* console_;
+        mutex console_mutex_;
+        static streambuf*& target() {
+            thread_local streambuf* t = nullptr;
+            return t;
+        }
+    protected:
+        int_type overflow(int_type ch) override {
+            if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+            const char c = traits_type::to_char_type(ch);
+            return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+        }
+        streamsize xsputn(const char* s, streamsize n) override {
+            if (streambuf* t = target()) return t->sputn(s, n);
+            lock_guard<mutex> lock(console_mutex_);
+            return console_->sputn(s, n);
+        }
+        int sync() override {
+            if (streambuf* t = target()) return t->pubsync();
+            lock_guard<mutex> lock(console_mutex_);
+            return console_->pubsync();
+        }
+    public:
+        explicit ThreadRoutingBuffer(streambuf* console) : console_(console) {}
+        static void route_current_thread(streambuf* buffer) { target() = buffer; }
+    };
+
+    vector<BatchJob> jobs_;
+    BatchOptions options_;
+
+    // ״̬
+    mutex mutex_;
+    condition_variable released_;
+    size_t free_threads_ = 0;
+    size_t free_bytes_ = 0;
+    size_t largest_nodes_ = 0;
+
+    // ˽й߷
+    void load_manifest(const string& manifest_path);
+    void plan();
+    size_t thread_share(const BatchJob& job, size_t largest) const;
+    size_t borrow_threads(size_t wanted);
+    void return_threads(size_t count);
+    void execute(BatchJob& job);
+    static size_t read_node_count(const string& path);
+
+public:
+    BatchScheduler(const string& manifest_path, const BatchOptions& options = BatchOptions());
+
+    void run();
+    const vector<BatchJob>& jobs() const { return jobs_; }
+    size_t failed_count() const;
+    void export_summary(const string& output_path) const;
+
+    // ڣClustering.exe --batch 嵥 Ŀ¼ [ڴMB] [߳]
+    // ֱֵΪ˳룺ȫɹΪ 0Ϊ 1
+    static int run_from_command_line(int argc, char* argv[]);
+};
+
+/**************** Աʵ ****************/
+
+// 캯ȡ嵥ÿҵĹģȡ
+BatchScheduler::BatchScheduler(const string& manifest_path, const BatchOptions& options)
+    : options_(options) {
+    if (options_.memory_budget_mb == 0) {
+        throw invalid_argument("ڴޱ 0");
+    }
+    load_manifest(manifest_path);
+    plan();
+}
+
+// 嵥Ｏбһŷֺд
+void BatchScheduler::load_manifest(const string& manifest_path) {
+    ifstream file(manifest_path);
+    if (!file) throw runtime_error("޷嵥ļ: " + manifest_path);
+
+    string line;
+    size_t line_number = 0;
+    while (getline(file, line)) {
+        ++line_number;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') continue;
+
+        vector<string> fields;
+        istringstream iss(line);
+        string field;
+        while (getline(iss, field, '\t')) fields.push_back(field);
+        if (fields.size() < 5 || fields.size() > 6) {
+            throw runtime_error("嵥 " + to_string(line_number) + " Ӧ 5  6 УʵΪ " + to_string(fields.size()));
+        }
+
+        BatchJob job;
+        job.line = line_number;
+        job.input = fields[0];
+        try {
+            job.small_threshold = stod(fields[1]);
+            job.medium_threshold = stod(fields[2]);
+            job.large_threshold = stod(fields[3]);
+            job.min_neighbors = stoul(fields[4]);
+        }
+        catch (const exception&) {
+            throw runtime_error("嵥 " + to_string(line_number) + " вʽ");
+        }
+        job.name = fields.size() == 6 && !fields[5].empty()
+            ? fields[5] : filesystem::path(job.input).stem().string();
+        jobs_.push_back(job);
+    }
+    if (jobs_.empty()) {
+        throw runtime_error("嵥ûҵ: " + manifest_path);
+    }
+
+    // ҵӺ׺֤Ŀ¼ͬӺ׺Ҳ嵥еҵͬ
+    //  a_2aa׺ֱδռ
+    unordered_set<string> used;
+    for (BatchJob& job : jobs_) {
+        if (used.count(job.name)) {
+            size_t suffix = 2;
+            while (used.count(job.name + "_" + to_string(suffix))) ++suffix;
+            job.name += "_" + to_string(suffix);
+        }
+        used.insert(job.name);
+    }
+}
+
+// ֻȡͷõڵ
+size_t BatchScheduler::read_node_count(const string& path) {
+    MatrixInputStream file(path);
+    if (!file) throw runtime_error("޷ļ: " + path);
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) throw runtime_error("ļΪ: " + path);
+    return reader.tokens().size();
+}
+
+// ڴ沢ѡ档CsrGraph ԳܾԼ N(N-1) ߣÿ 4 ֽĿꡢ
+// 8 ֽȨء4 ֽڷƫƺ 1 λĹÿڵԼ 100 ֽڣID ַ
+// ޷ȡͷҵִн׶α
+void BatchScheduler::plan() {
+    const size_t budget = options_.memory_budget_mb * 1024 * 1024;
+    for (BatchJob& job : jobs_) {
+        job.output_dir = (filesystem::path(options_.output_root) / job.name).string();
+        try {
+            job.nodes = read_node_count(job.input);
+        }
+        catch (const exception& e) {
+            job.message = e.what();
+            job.engine = "csr";
+            continue;
+        }
+        const double edges = static_cast<double>(job.nodes) * (job.nodes > 0 ? job.nodes - 1 : 0);
+        const double csr_bytes = edges * (4 + 8 + 4 + 0.125) + job.nodes * 100.0;
+        if (csr_bytes <= budget) {
+            job.engine = "csr";
+            job.estimated_bytes = static_cast<size_t>(csr_bytes);
+        }
+        else {
+            job.engine = "stream";
+            job.estimated_bytes = budget;
+        }
+    }
+}
+
+// ߳ڱҵõȫ߳
+size_t BatchScheduler::thread_share(const BatchJob& job, size_t largest) const {
+    const size_t total = resolve_thread_count(options_.threads);
+    if (largest <= 1) return 1;
+    const double ratio = (static_cast<double>(job.nodes) * job.nodes) / (static_cast<double>(largest) * largest);
+    return max<size_t>(1, min(total, static_cast<size_t>(ratio * total + 0.5)));
+}
+
+// ȴֻȡǰе̣߳Ϊ 0
+size_t BatchScheduler::borrow_threads(size_t wanted) {
+    lock_guard<mutex> lock(mutex_);
+    const size_t granted = min(wanted, free_threads_);
+    free_threads_ -= granted;
+    return granted;
+}
+
+void BatchScheduler::return_threads(size_t count) {
+    if (count == 0) return;
+    lock_guard<mutex> lock(mutex_);
+    free_threads_ += count;
+    released_.notify_all();
+}
+
+// ѭ̰߳˳ѡܷµҵҵʱ黹߳ڴ
+void BatchScheduler::run() {
+    LSPQ_PROFILE_SCOPE("BatchScheduler::run");
+    filesystem::create_directories(options_.output_root);
+
+    const size_t total_threads = resolve_thread_count(options_.threads);
+    const size_t budget = options_.memory_budget_mb * 1024 * 1024;
+    free_threads_ = total_threads;
+    free_bytes_ = budget;
+
+    vector<size_t> pending(jobs_.size());
+    for (size_t i = 0; i < pending.size(); ++i) pending[i] = i;
+    stable_sort(pending.begin(), pending.end(), [&](size_t a, size_t b) {
+        return jobs_[a].estimated_bytes > jobs_[b].estimated_bytes;
+    });
+    largest_nodes_ = 0;
+    for (const BatchJob& job : jobs_) largest_nodes_ = max(largest_nodes_, job.nodes);
+
+    cout << ": " << jobs_.size() << " ҵ, " << total_threads << " ߳, ڴ "
+        << options_.memory_budget_mb << " MB" << endl;
+
+    ThreadRoutingBuffer router(cout.rdbuf());
+    streambuf* console = cout.rdbuf(&router);
+    vector<thread> workers;
+    try {
+        unique_lock<mutex> lock(mutex_);
+        while (!pending.empty()) {
+            // ׷ŲʱСҵûҵʱױضŵ
+            auto next = find_if(pending.begin(), pending.end(), [&](size_t i) {
+                return jobs_[i].estimated_bytes <= free_bytes_;
+            });
+            if (free_threads_ == 0 || next == pending.end()) {
+                released_.wait(lock);
+                continue;
+            }
+            BatchJob& job = jobs_[*next];
+            pending.erase(next);
+            if (job.engine == "csr") {
+                job.threads = 1;
+            }
+            else {
+                // ҵŶʱһ̸߳Сҵ
+                const size_t available = pending.empty() || free_threads_ == 1 ? free_threads_ : free_threads_ - 1;
+                job.threads = min(thread_share(job, largest_nodes_), available);
+            }
+            free_threads_ -= job.threads;
+            free_bytes_ -= job.estimated_bytes;
+            workers.emplace_back([this, &job] {
+                execute(job);
+                lock_guard<mutex> guard(mutex_);
+                free_threads_ += job.threads;
+                free_bytes_ += job.estimated_bytes;
+                released_.notify_all();
+            });
+        }
+    }
+    catch (...) {
+        for (thread& w : workers) w.join();
+        cout.rdbuf(console);
+        throw;
+    }
+    for (thread& w : workers) w.join();
+    cout.rdbuf(console);
+
+    const string summary_path = (filesystem::path(options_.output_root) / "batch_summary.tsv").string();
+    export_summary(summary_path);
+    cout << ": " << jobs_.size() - failed_count() << " ɹ, " << failed_count()
+        << " ʧ, ܱ: " << summary_path << endl;
+}
+
+// ڹִ߳еҵ뵥ļģʽͬ쳣¼ҵж׳
+void BatchScheduler::execute(BatchJob& job) {
+    const auto start = chrono::steady_clock::now();
+    try {
+        if (!job.message.empty()) throw runtime_error(job.message);
+        filesystem::create_directories(job.output_dir);
+        ofstream log(filesystem::path(job.output_dir) / "log.txt");
+        if (!log) throw runtime_error("޷־ļ: " + job.output_dir);
+        ThreadRoutingBuffer::route_current_thread(log.rdbuf());
+
+        try {
+            const string dir = job.output_dir + "/";
+            cout << "ļ: " << job.input << "\nֵ: " << job.small_threshold << ", "
+                << job.medium_threshold << ", " << job.large_threshold << "\nھ: "
+                << job.min_neighbors << "\n: " << job.engine << ", ߳: " << job.threads << "\n";
+            if (job.engine == "csr") {
+                CsrGraph graph(job.input);
+                SymmetryReport report;
+                {
+                    // ʱỵ̈߳뿪򣨰׳쳣ʱ黹
+                    struct Borrowed {
+                        BatchScheduler* scheduler;
+                        size_t count;
+                        ~Borrowed() { scheduler->return_threads(count); }
+                    } borrowed{ this, borrow_threads(thread_share(job, largest_nodes_) - 1) };
+                    SymmetryCheckOptions symmetry;
+                    symmetry.threads = job.threads + borrowed.count;
+                    job.symmetry_threads = symmetry.threads;
+                    cout << "ԳԼ߳: " << symmetry.threads << "\n";
+                    report = graph.check_symmetry(symmetry);
+                }
+                if (!report.passed()) {
+                    graph.print_symmetry_report(report);
+                    throw runtime_error("ͼԳƻ");
+                }
+                graph.perform_neighborhood_analysis(job.small_threshold, job.medium_threshold,
+                    job.large_threshold, job.min_neighbors);
+                job.components = static_cast<size_t>(graph.count_connected_components());
+                graph.export_adjacency_matrix(dir + "adjacency_matrix.txt");
+                graph.export_all_components_to_single_file(dir + "all_components.txt");
+                graph.export_edge_list_for_cytoscape(dir + "network_for_cytoscape.txt", "similarity_link");
+                graph.export_all_component_adjacency_matrices_to_single_file(dir + "all_component_adjacency_matrices.txt");
+                graph.export_statistics_tsv(dir + "graph_statistics.tsv");
+                graph.export_statistics_json(dir + "graph_statistics.json");
+            }
+            else {
+                StreamingOptions streaming;
+                streaming.memory_budget_mb = options_.memory_budget_mb;
+                streaming.temp_dir = job.output_dir;
+                streaming.threads = job.threads;
+                StreamingGraph graph(job.input, streaming);
+                graph.perform_neighborhood_analysis(job.small_threshold, job.medium_threshold,
+                    job.large_threshold, job.min_neighbors);
+                job.components = static_cast<size_t>(graph.count_connected_components());
+                graph.export_adjacency_matrix(dir + "adjacency_matrix.txt");
+                graph.export_all_components_to_single_file(dir + "all_components.txt");
+                graph.export_edge_list_for_cytoscape(dir + "network_for_cytoscape.txt", "similarity_link");
+                graph.export_all_component_adjacency_matrices_to_single_file(dir + "all_component_adjacency_matrices.txt");
+            }
+            job.succeeded = true;
+        }
+        catch (const exception& e) {
+            cout << ": " << e.what() << "\n";
+            ThreadRoutingBuffer::route_current_thread(nullptr);
+            throw;
+        }
+        cout.flush();
+        ThreadRoutingBuffer::route_current_thread(nullptr);
+    }
+    catch (const exception& e) {
+        job.succeeded = false;
+        job.message = e.what();
+    }
+    job.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // ֻ̨ʾһн
+    ostringstream progress;
+    progress << "[" << job.name << "] " << (job.succeeded ? "" : "ʧ") << ": "
+        << job.nodes << " ڵ, " << job.threads << " ߳";
+    if (job.symmetry_threads > job.threads) progress << "ԳԼ " << job.symmetry_threads << " ";
+    progress << ", " << fixed << setprecision(2)
+        << job.seconds << " s";
+    if (job.succeeded) progress << ", " << job.components << " ֧ͨ";
+    else progress << ", " << job.message;
+    cout << progress.str() << endl;
+}
+
+size_t BatchScheduler::failed_count() const {
+    return static_cast<size_t>(count_if(jobs_.begin(), jobs_.end(), [](const BatchJob& job) {
+        return !job.succeeded;
+    }));
+}
+
+// ܱÿҵһУ嵥˳
+void BatchScheduler::export_summary(const string& output_path) const {
+    ofstream outfile(output_path);
+    if (!outfile) throw runtime_error("޷ļ: " + output_path);
+
+    outfile << "job\tinput\tsmall\tmedium\tlarge\tmin_neighbors\tnodes\tengine\tthreads\t"
+        "estimated_mb\tseconds\tcomponents\tstatus\tmessage\toutput_dir\n";
+    for (const BatchJob& job : jobs_) {
+        // ʽֻڴʱھֲɣ⾫Ӱеֵ
+        ostringstream cost;
+        cost << fixed << setprecision(1) << job.estimated_bytes / (1024.0 * 1024.0) << "\t"
+            << setprecision(3) << job.seconds;
+        outfile << job.name << "\t" << job.input << "\t" << job.small_threshold << "\t"
+            << job.medium_threshold << "\t" << job.large_threshold << "\t" << job.min_neighbors << "\t"
+            << job.nodes << "\t" << job.engine << "\t" << job.threads << "\t"
+            << cost.str() << "\t"
+            << job.components << "\t" << (job.succeeded ? "ok" : "failed") << "\t"
+            << job.message << "\t" << job.output_dir << "\n";
+    }
+}
+
+int BatchScheduler::run_from_command_line(int argc, char* argv[]) {
+    if (argc < 4 || string(argv[1]) != "--batch") {
+        cerr << "÷: " << (argc > 0 ? argv[0] : "Clustering") << " --batch 嵥 Ŀ¼ [ڴMB] [߳]" << endl;
+        return 1;
+    }
+    try {
+        BatchOptions options;
+        options.output_root = argv[3];
+        if (argc > 4) options.memory_budget_mb = stoul(argv[4]);
+        if (argc > 5) options.threads = stoul(argv[5]);
+        BatchScheduler scheduler(argv[2], options);
+        scheduler.run();
+        return scheduler.failed_count() == 0 ? 0 : 1;
+    }
+    catch (const exception& e) {
+        cerr << ": " << e.what() << endl;
+        return 1;
+    }
+}
+
+#endif // LSPQ_BATCH_SCHEDULER_HPP
@@ -0,0 +1,492 @@
+/**
+ ********************************************
+ * @file    :CommunityDetection.hpp
+ * @author  :XXY
+ * @brief   :Per-component Louvain/Leiden community detection
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_COMMUNITY_DETECTION_HPP
+#define LSPQ_COMMUNITY_DETECTION_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <iomanip>
+
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+struct CommunityOptions {
+    double resolution = 1.0;     // ģȷֱ ãԽԽС
+    uint64_t seed = 42;          // ÿ֧ͨ seed ֧ȷ߳޹
+    size_t max_levels = 32;      // ۺϲ
+    size_t min_component_size = 3;  // Сڸùģ֧ͨΪһ
+    size_t threads = 0;          // 0 ʾȫӲ߳
+};
+
+// ڼ֦ļȨͼģ֣Louvain ֲƶ + Leiden ϸ
+// ֧֮ͨûбߣģȵŻֲԽ֧ÿ֧֧֮䲢С
+// ÿһ㣺ֲƶʽֻ·ھ仯Ľڵ㣩 ÿڲϸ
+// ֻϲõ֤ڲͨ  ϸۺϳһͼ
+// ۺϽڵĳʼȡϸǰֲƶٸıκνڵʱ
+class CommunityDetector {
+    // һļȨͼڽӱѹԻ (i, i) ԪشţֵΪڲȨ֮͵
+    struct LevelGraph {
+        vector<size_t> offsets;
+        vector<uint32_t> targets;
+        vector<double> weights;
+        vector<double> degree;  // ÿڵļȨȣԻ
+        double total = 0.0;     // 2m
+        size_t size() const { return degree.size(); }
+    };
+
+    struct Component {
+        vector<string> names;
+        LevelGraph graph;
+        vector<uint32_t> membership;  // ԭʼڵ -> ֧ţСڵ±
+        size_t community_count = 0;
+        double modularity = 0.0;
+    };
+
+    CommunityOptions options_;
+    vector<Component> components_;
+
+    static void finish_graph(LevelGraph& graph);
+    static uint64_t component_seed(uint64_t seed, size_t component);
+
+    bool move_nodes(const LevelGraph& graph, vector<uint32_t>& community, mt19937_64& rng) const;
+    vector<uint32_t> refine(const LevelGraph& graph, const vector<uint32_t>& community, mt19937_64& rng) const;
+    static LevelGraph aggregate(const LevelGraph& graph, const vector<uint32_t>& partition, size_t parts);
+    static size_t renumber(vector<uint32_t>& partition);
+    double modularity(const LevelGraph& graph, const vector<uint32_t>& membership) const;
+    void detect(Component& component, size_t index) const;
+
+public:
+    CommunityDetector(const Graph& graph, const CommunityOptions& options = CommunityOptions());
+    CommunityDetector(const CsrGraph& graph, const CommunityOptions& options = CommunityOptions());
+
+    void run();
+    size_t community_count() const;
+    // ÿ֧ͨڵ֧˳ get_connected_components ͬ
+    vector<vector<vector<string>>> get_communities() const;
+
+    // ʽ export_all_components_to_single_file ͬע֧ͨ
+    void export_communities_to_single_file(const string& output_file_path) const;
+};
+
+/**************** Աʵ ****************/
+
+CommunityDetector::CommunityDetector(const Graph& graph, const CommunityOptions& options) : options_(options) {
+    LSPQ_PROFILE_SCOPE("CommunityDetector::build");
+    if (!(options.resolution > 0.0)) throw invalid_argument("ֱʱ 0");
+
+    vector<vector<string>> components = graph.get_connected_components();
+    components_.resize(components.size());
+    parallel_for_blocks(components.size(), 1, options.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t c = begin; c < end; ++c) {
+            Component& component = components_[c];
+            component.names = move(components[c]);
+            unordered_map<string, uint32_t> local;
+            for (uint32_t i = 0; i < component.names.size(); ++i) local.emplace(component.names[i], i);
+
+            LevelGraph& g = component.graph;
+            g.offsets.assign(1, 0);
+            for (const string& name : component.names) {
+                for (const auto& edge : graph.neighbor_edges(name)) {
+                    g.targets.push_back(local.at(string(edge.first)));
+                    g.weights.push_back(edge.second);
+                }
+                g.offsets.push_back(g.targets.size());
+            }
+            finish_graph(g);
+        }
+    });
+}
+
+CommunityDetector::CommunityDetector(const CsrGraph& graph, const CommunityOptions& options) : options_(options) {
+    LSPQ_PROFILE_SCOPE("CommunityDetector::build");
+    if (!(options.resolution > 0.0)) throw invalid_argument("ֱʱ 0");
+
+    const vector<vector<uint32_t>> components = graph.component_indices();
+    // ÿڵֻһ֧ͨ߳дλûص
+    vector<uint32_t> local(graph.node_count());
+    components_.resize(components.size());
+    parallel_for_blocks(components.size(), 1, options.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t c = begin; c < end; ++c) {
+            const vector<uint32_t>& nodes = components[c];
+            for (uint32_t i = 0; i < nodes.size(); ++i) local[nodes[i]] = i;
+
+            Component& component = components_[c];
+            LevelGraph& g = component.graph;
+            g.offsets.assign(1, 0);
+            for (uint32_t node : nodes) {
+                component.names.push_back(graph.node_ids()[node]);
+                graph.for_each_neighbor(node, [&](uint32_t target, double weight) {
+                    g.targets.push_back(local[target]);
+                    g.weights.push_back(weight);
+                });
+                g.offsets.push_back(g.targets.size());
+            }
+            finish_graph(g);
+        }
+    });
+}
+
+void CommunityDetector::finish_graph(LevelGraph& graph) {
+    const size_t n = graph.offsets.size() - 1;
+    graph.degree.assign(n, 0.0);
+    graph.total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e) graph.degree[i] += graph.weights[e];
+        graph.total += graph.degree[i];
+    }
+}
+
+uint64_t CommunityDetector::component_seed(uint64_t seed, size_t component) {
+    // splitmix64
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (component + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// ѹΪ 0..k-1״γֵĽڵ˳򣩣
+size_t CommunityDetector::renumber(vector<uint32_t>& partition) {
+    vector<uint32_t> mapping(partition.size(), UINT32_MAX);
+    uint32_t next = 0;
+    for (uint32_t& c : partition) {
+        if (mapping[c] == UINT32_MAX) mapping[c] = next++;
+        c = mapping[c];
+    }
+    return next;
+}
+
+// ֲƶѽڵģǷнڵƶ
+bool CommunityDetector::move_nodes(const LevelGraph& graph, vector<uint32_t>& community, mt19937_64& rng) const {
+    const size_t n = graph.size();
+    const double scale = options_.resolution / graph.total;
+
+    vector<double> total(n, 0.0);
+    vector<uint32_t> members(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        total[community[i]] += graph.degree[i];
+        ++members[community[i]];
+    }
+    vector<uint32_t> empty;
+    for (uint32_t c = n; c-- > 0;) {
+        if (members[c] == 0) empty.push_back(c);
+    }
+
+    vector<uint32_t> queue(n);
+    iota(queue.begin(), queue.end(), 0);
+    shuffle(queue.begin(), queue.end(), rng);
+    vector<char> queued(n, 1);
+    size_t head = 0;
+
+    vector<double> link(n, 0.0);
+    vector<uint32_t> touched;
+    bool moved = false;
+
+    while (head < queue.size()) {
+        const uint32_t node = queue[head++];
+        queued[node] = 0;
+        const uint32_t current = community[node];
+        const double k = graph.degree[node];
+
+        touched.clear();
+        for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+            const uint32_t target = graph.targets[e];
+            if (target == node) continue;
+            const uint32_t c = community[target];
+            if (link[c] == 0.0) touched.push_back(c);
+            link[c] += graph.weights[e];
+        }
+
+        // ȰѽڵӵǰȡٱȽϸѡ k_i,C -  k_i _C / 2m
+        total[current] -= k;
+        --members[current];
+        uint32_t best = current;
+        double best_gain = link[current] - k * total[current] * scale;
+        for (uint32_t c : touched) {
+            const double gain = link[c] - k * total[c] * scale;
+            if (gain > best_gain + 1e-12) {
+                best = c;
+                best_gain = gain;
+            }
+        }
+        if (best_gain < 0.0 && members[current] > 0 && !empty.empty()) {
+            best = empty.back();
+            best_gain = 0.0;
+        }
+        for (uint32_t c : touched) link[c] = 0.0;
+        link[current] = 0.0;
+
+        if (best != current) {
+            if (members[current] == 0) empty.push_back(current);
+            if (members[best] == 0) empty.erase(find(empty.begin(), empty.end(), best));
+            moved = true;
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+                const uint32_t target = graph.targets[e];
+                if (!queued[target] && community[target] != best) {
+                    queued[target] = 1;
+                    queue.push_back(target);
+                }
+            }
+        }
+        community[node] = best;
+        total[best] += k;
+        ++members[best];
+    }
+    return moved;
+}
+
+// Leiden ϸÿڲӵڵֻõĵڵ㲢õ
+// ȡһõͨ
+vector<uint32_t> CommunityDetector::refine(const LevelGraph& graph, const vector<uint32_t>& community,
+    mt19937_64& rng) const {
+    const size_t n = graph.size();
+    const double scale = options_.resolution / graph.total;
+
+    vector<double> community_total(n, 0.0);
+    for (size_t i = 0; i < n; ++i) community_total[community[i]] += graph.degree[i];
+
+    // external[r] r ಿ֮ıȨ
+    vector<uint32_t> refined(n);
+    iota(refined.begin(), refined.end(), 0);
+    vector<double> refined_total(graph.degree);
+    vector<double> external(n, 0.0);
+    vector<char> singleton(n, 1);
+    for (uint32_t i = 0; i < n; ++i) {
+        for (size_t e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e) {
+            const uint32_t target = graph.targets[e];
+            if (target != i && community[target] == community[i]) external[i] += graph.weights[e];
+        }
+    }
+
+    vector<uint32_t> order(n);
+    iota(order.begin(), order.end(), 0);
+    shuffle(order.begin(), order.end(), rng);
+
+    vector<double> link(n, 0.0);
+    vector<uint32_t> touched;
+    for (uint32_t node : order) {
+        if (!singleton[node]) continue;
+        const double k = graph.degree[node];
+        const double whole = community_total[community[node]];
+        if (external[node] < k * (whole - k) * scale) continue;
+
+        touched.clear();
+        for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+            const uint32_t target = graph.targets[e];
+            if (target == node || community[target] != community[node]) continue;
+            const uint32_t r = refined[target];
+            if (link[r] == 0.0) touched.push_back(r);
+            link[r] += graph.weights[e];
+        }
+
+        uint32_t best = node;
+        double best_gain = 0.0;
+        for (uint32_t r : touched) {
+            const double size = refined_total[r];
+            if (external[r] < size * (whole - size) * scale) continue;
+            const double gain = link[r] - k * size * scale;
+            if (gain > best_gain + 1e-12) {
+                best = r;
+                best_gain = gain;
+            }
+        }
+
+        if (best != node) {
+            external[best] += external[node] - 2.0 * link[best];
+            refined_total[best] += k;
+            refined_total[node] = 0.0;
+            refined[node] = best;
+            singleton[node] = 0;
+            singleton[best] = 0;
+        }
+        for (uint32_t r : touched) link[r] = 0.0;
+    }
+    return refined;
+}
+
+CommunityDetector::LevelGraph CommunityDetector::aggregate(const LevelGraph& graph,
+    const vector<uint32_t>& partition, size_t parts) {
+    vector<vector<uint32_t>> members(parts);
+    for (uint32_t i = 0; i < graph.size(); ++i) members[partition[i]].push_back(i);
+
+    LevelGraph next;
+    next.offsets.assign(1, 0);
+    vector<double> link(parts, 0.0);
+    vector<uint32_t> touched;
+    for (size_t p = 0; p < parts; ++p) {
+        touched.clear();
+        for (uint32_t node : members[p]) {
+            for (size_t e = graph.offsets[node]; e < graph.offsets[node + 1]; ++e) {
+                const uint32_t target = partition[graph.targets[e]];
+                if (link[target] == 0.0) touched.push_back(target);
+                link[target] += graph.weights[e];
+            }
+        }
+        sort(touched.begin(), touched.end());
+        for (uint32_t target : touched) {
+            next.targets.push_back(target);
+            next.weights.push_back(link[target]);
+            link[target] = 0.0;
+        }
+        next.offsets.push_back(next.targets.size());
+    }
+    finish_graph(next);
+    return next;
+}
+
+double CommunityDetector::modularity(const LevelGraph& graph, const vector<uint32_t>& membership) const {
+    if (graph.total <= 0.0) return 0.0;
+    const size_t parts = *max_element(membership.begin(), membership.end()) + 1;
+    vector<double> inside(parts, 0.0), total(parts, 0.0);
+    for (uint32_t i = 0; i < graph.size(); ++i) {
+        total[membership[i]] += graph.degree[i];
+        for (size_t e = graph.offsets[i]; e < graph.offsets[i + 1]; ++e) {
+            if (membership[graph.targets[e]] == membership[i]) inside[membership[i]] += graph.weights[e];
+        }
+    }
+    double q = 0.0;
+    for (size_t c = 0; c < parts; ++c) {
+        const double share = total[c] / graph.total;
+        q += inside[c] / graph.total - options_.resolution * share * share;
+    }
+    return q;
+}
+
+void CommunityDetector::detect(Component& component, size_t index) const {
+    const size_t n = component.names.size();
+    component.membership.assign(n, 0);
+    if (n < max<size_t>(options_.min_component_size, 1) || component.graph.total <= 0.0) {
+        component.community_count = n ? 1 : 0;
+        component.modularity = modularity(component.graph, component.membership);
+        return;
+    }
+
+    mt19937_64 rng(component_seed(options_.seed, index));
+    LevelGraph level = component.graph;
+    vector<uint32_t> community(n);
+    iota(community.begin(), community.end(), 0);
+    vector<uint32_t> node_level(n);  // ԭʼڵ -> ǰڵ
+    iota(node_level.begin(), node_level.end(), 0);
+
+    for (size_t depth = 0; depth < options_.max_levels; ++depth) {
+        if (!move_nodes(level, community, rng)) break;
+        const size_t parts = renumber(community);
+        if (parts == level.size()) break;
+
+        // ϸûкϲκνڵʱ˻ΪۺϣLouvain֤ÿģС
+        vector<uint32_t> refined = refine(level, community, rng);
+        size_t refined_parts = renumber(refined);
+        if (refined_parts == level.size()) {
+            refined = community;
+            refined_parts = parts;
+        }
+
+        vector<uint32_t> next_community(refined_parts);
+        for (uint32_t i = 0; i < level.size(); ++i) next_community[refined[i]] = community[i];
+        for (uint32_t& node : node_level) node = refined[node];
+        level = aggregate(level, refined, refined_parts);
+        community = move(next_community);
+    }
+
+    for (uint32_t i = 0; i < n; ++i) component.membership[i] = community[node_level[i]];
+    component.community_count = renumber(component.membership);
+    component.modularity = modularity(component.graph, component.membership);
+}
+
+void CommunityDetector::run() {
+    LSPQ_PROFILE_SCOPE("CommunityDetector::run");
+    cout << "ʼ...\n";
+    cout << "ֱ: " << options_.resolution << ", : " << options_.seed << "\n";
+
+    // ֧ȴֻʣһ߳ķ֧
+    vector<size_t> order(components_.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return components_[a].graph.targets.size() > components_[b].graph.targets.size();
+    });
+    parallel_for_blocks(order.size(), 1, options_.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) detect(components_[order[i]], order[i]);
+    });
+
+    size_t split = 0;
+    double largest_modularity = 0.0;
+    size_t largest = 0;
+    for (const auto& component : components_) {
+        if (component.community_count > 1) ++split;
+        if (component.names.size() > largest) {
+            largest = component.names.size();
+            largest_modularity = component.modularity;
+        }
+    }
+    ostringstream report;
+    report << fixed << setprecision(4)
+        << components_.size() << " ֳ֧ͨ " << community_count() << "  "
+        << split << " ֧\n"
+        << "֧ͨ" << largest << " ڵ㣩ģ: " << largest_modularity << "\n";
+    cout << report.str();
+}
+
+size_t CommunityDetector::community_count() const {
+    size_t count = 0;
+    for (const auto& component : components_) count += component.community_count;
+    return count;
+}
+
+vector<vector<vector<string>>> CommunityDetector::get_communities() const {
+    vector<vector<vector<string>>> all_communities;
+    for (const auto& component : components_) {
+        vector<vector<string>> communities(component.community_count);
+        for (size_t i = 0; i < component.names.size(); ++i) {
+            communities[component.membership[i]].push_back(component.names[i]);
+        }
+        all_communities.push_back(move(communities));
+    }
+    return all_communities;
+}
+
+void CommunityDetector::export_communities_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("CommunityDetector::export_communities_to_single_file");
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    cout << " " << community_count() << " ڵļ: " << output_file_path << endl;
+
+    const vector<vector<vector<string>>> all_communities = get_communities();
+    size_t number = 0;
+    for (size_t c = 0; c < all_communities.size(); ++c) {
+        for (const auto& community : all_communities[c]) {
+            outfile << "Community " << ++number << " (Component: " << (c + 1)
+                << ", Nodes: " << community.size() << "):\n";
+            for (const string& node_id : community) {
+                outfile << node_id << "\n";
+            }
+            outfile << "\n";
+        }
+    }
+
+    outfile.close();
+    cout << "ѵ: " << output_file_path << endl;
+}
+
+#endif // LSPQ_COMMUNITY_DETECTION_HPP
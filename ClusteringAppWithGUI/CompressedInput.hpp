@@ -0,0 +1,271 @@
+/**
+ ********************************************
+ * @file    :CompressedInput.hpp
+ * @author  :XXY
+ * @brief   :Transparent gzip/zstd matrix input with pipelined decompression
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_COMPRESSED_INPUT_HPP
+#define LSPQ_COMPRESSED_INPUT_HPP
+
+#include <istream>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <stdexcept>
+
+#include "Parallel.hpp"
+
+//  LSPQ_WITH_ZLIB / LSPQ_WITH_ZSTD ӦĿܶȡ gzip / zstd ѹľ
+// δʱѹļȷĴ󣬶ǰѹݵı
+#ifdef LSPQ_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LSPQ_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+
+enum class InputCompression { None, Gzip, Zstd };
+
+// ļͷħжѹʽչ޹أ޷ʱδѹɵ÷ʧ
+inline InputCompression detect_compression(const string& path) {
+    ifstream file(path, ios::binary);
+    unsigned char magic[4] = { 0, 0, 0, 0 };
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    const streamsize got = file.gcount();
+    if (got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return InputCompression::Gzip;
+    if (got == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return InputCompression::Zstd;
+    }
+    return InputCompression::None;
+}
+
+// ˮߣȡ̰߳ѹݣѹ̰߳гԻнβĿ飬
+// ̣߳÷ͨ underflow ȡá֮䶼нУ
+// ˴̶ȡѹصڴռòԼ (2 *  + 2) 顣
+// һ̨̳߳ʱرУڽ߳һȡʱ׳
+class DecompressingStreambuf : public streambuf {
+    static constexpr size_t kChunkBytes = size_t(1) << 20; // ÿζȡѹ
+    static constexpr size_t kBlockBytes = size_t(1) << 20; // ĿĿС
+    static constexpr size_t kQueueDepth = 4;
+
+    ifstream file_;
+    InputCompression compression_;
+    BoundedQueue<string> raw_;
+    BoundedQueue<string> blocks_;
+    string current_;
+    mutex error_mutex_;
+    exception_ptr error_;
+    thread reader_;
+    thread decompressor_;
+
+    // ˽й߷
+    void fail(exception_ptr error);
+    void read_loop();
+    void decompress_loop();
+    template <typename Emit> void inflate_gzip(Emit& emit);
+    template <typename Emit> void decompress_zstd(Emit& emit);
+
+protected:
+    int_type underflow() override;
+
+public:
+    DecompressingStreambuf(const string& path, InputCompression compression);
+    ~DecompressingStreambuf();
+    DecompressingStreambuf(const DecompressingStreambuf&) = delete;
+    DecompressingStreambuf& operator=(const DecompressingStreambuf&) = delete;
+};
+
+// δѹļֱʹ filebufԭ ifstream Ϊͬ
+// ѹļ DecompressingStreambuf ѹѹԭʼ쳣׳ᱻļǰ
+class MatrixInputStream : public istream {
+    unique_ptr<streambuf> buffer_;
+    InputCompression compression_ = InputCompression::None;
+
+public:
+    explicit MatrixInputStream(const string& path);
+
+    InputCompression compression() const { return compression_; }
+};
+
+/**************** Աʵ ****************/
+
+DecompressingStreambuf::DecompressingStreambuf(const string& path, InputCompression compression)
+    : file_(path, ios::binary), compression_(compression), raw_(kQueueDepth), blocks_(kQueueDepth) {
+    if (!file_) throw runtime_error("޷ļ: " + path);
+    reader_ = thread(&DecompressingStreambuf::read_loop, this);
+    decompressor_ = thread(&DecompressingStreambuf::decompress_loop, this);
+}
+
+// ǰ׳쳣ʱرնУų́߳̾˳
+DecompressingStreambuf::~DecompressingStreambuf() {
+    raw_.close();
+    blocks_.close();
+    if (reader_.joinable()) reader_.join();
+    if (decompressor_.joinable()) decompressor_.join();
+}
+
+void DecompressingStreambuf::fail(exception_ptr error) {
+    {
+        lock_guard<mutex> lock(error_mutex_);
+        if (!error_) error_ = error;
+    }
+    raw_.close();
+    blocks_.close();
+}
+
+void DecompressingStreambuf::read_loop() {
+    try {
+        while (true) {
+            string chunk(kChunkBytes, '\0');
+            file_.read(&chunk[0], static_cast<streamsize>(chunk.size()));
+            chunk.resize(static_cast<size_t>(file_.gcount()));
+            if (chunk.empty()) break;
+            if (!raw_.push(move(chunk))) return;
+        }
+        if (file_.bad()) throw runtime_error("ȡѹļʧ");
+    }
+    catch (...) {
+        fail(current_exception());
+        return;
+    }
+    raw_.close();
+}
+
+// ѹۻĿСһдпʣಿһ顣
+// гĿСʱۻֱֻС
+void DecompressingStreambuf::decompress_loop() {
+    try {
+        string pending;
+        pending.reserve(kBlockBytes * 2);
+        auto emit = [&](const char* data, size_t size) {
+            pending.append(data, size);
+            if (pending.size() < kBlockBytes) return true;
+            const size_t cut = pending.rfind('\n');
+            if (cut == string::npos) return true;
+            string rest(pending, cut + 1);
+            pending.resize(cut + 1);
+            const bool open = blocks_.push(move(pending));
+            pending = move(rest);
+            pending.reserve(kBlockBytes * 2);
+            return open;
+        };
+
+        if (compression_ == InputCompression::Gzip) inflate_gzip(emit);
+        else decompress_zstd(emit);
+
+        if (!pending.empty()) blocks_.push(move(pending));
+    }
+    catch (...) {
+        fail(current_exception());
+        return;
+    }
+    blocks_.close();
+}
+
+// ֶ֧Ա gzip ļֶѹƴӣһԱʱýѹ
+template <typename Emit>
+void DecompressingStreambuf::inflate_gzip(Emit& emit) {
+#ifdef LSPQ_WITH_ZLIB
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) throw runtime_error("zlib ʼʧ");
+    struct InflateGuard {
+        z_stream* stream;
+        ~InflateGuard() { inflateEnd(stream); }
+    } guard{ &stream };
+
+    string out(kChunkBytes, '\0');
+    string chunk;
+    bool ended = false;
+    while (raw_.pop(chunk)) {
+        stream.next_in = reinterpret_cast<Bytef*>(&chunk[0]);
+        stream.avail_in = static_cast<uInt>(chunk.size());
+        bool more = true;
+        while (more) {
+            if (ended && stream.avail_in > 0) {
+                inflateReset(&stream);
+                ended = false;
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+            stream.avail_out = static_cast<uInt>(out.size());
+            const int ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END) {
+                ended = true;
+            }
+            else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                throw runtime_error(string("gzip : ") + (stream.msg ? stream.msg : to_string(ret)));
+            }
+            if (!emit(out.data(), out.size() - stream.avail_out)) return;
+            more = stream.avail_in > 0 || (stream.avail_out == 0 && !ended);
+        }
+    }
+    if (!ended) throw runtime_error("gzip ļ");
+#else
+    (void)emit;
+    throw runtime_error("ļΪ gzip ѹʽʱδ LSPQ_WITH_ZLIB");
+#endif
+}
+
+// zstd ʽѹԶԽ֡һηֵ 0 ˵һ֡
+template <typename Emit>
+void DecompressingStreambuf::decompress_zstd(Emit& emit) {
+#ifdef LSPQ_WITH_ZSTD
+    unique_ptr<ZSTD_DCtx, size_t(*)(ZSTD_DCtx*)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (!context) throw runtime_error("zstd ʼʧ");
+
+    string out(ZSTD_DStreamOutSize(), '\0');
+    string chunk;
+    size_t last = 0;
+    while (raw_.pop(chunk)) {
+        ZSTD_inBuffer input = { chunk.data(), chunk.size(), 0 };
+        while (true) {
+            ZSTD_outBuffer output = { &out[0], out.size(), 0 };
+            last = ZSTD_decompressStream(context.get(), &output, &input);
+            if (ZSTD_isError(last)) {
+                throw runtime_error(string("zstd : ") + ZSTD_getErrorName(last));
+            }
+            if (!emit(out.data(), output.pos)) return;
+            if (input.pos == input.size && output.pos < output.size) break;
+        }
+    }
+    if (last != 0) throw runtime_error("zstd ļ");
+#else
+    (void)emit;
+    throw runtime_error("ļΪ zstd ѹʽʱδ LSPQ_WITH_ZSTD");
+#endif
+}
+
+DecompressingStreambuf::int_type DecompressingStreambuf::underflow() {
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    if (!blocks_.pop(current_)) {
+        lock_guard<mutex> lock(error_mutex_);
+        if (error_) rethrow_exception(error_);
+        return traits_type::eof();
+    }
+    setg(&current_[0], &current_[0], &current_[0] + current_.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+// ѹ badbit 쳣istream  underflow ׳쳣ᰴ exceptions() ׳ԭ쳣
+MatrixInputStream::MatrixInputStream(const string& path) : istream(nullptr) {
+    compression_ = detect_compression(path);
+    if (compression_ == InputCompression::None) {
+        buffer_ = make_unique<filebuf>();
+        if (!static_cast<filebuf*>(buffer_.get())->open(path, ios::in)) return; //  badbit÷ʧܴ
+        rdbuf(buffer_.get());
+        return;
+    }
+    buffer_ = make_unique<DecompressingStreambuf>(path, compression_);
+    rdbuf(buffer_.get());
+    exceptions(ios::badbit);
+}
+
+#endif // LSPQ_COMPRESSED_INPUT_HPP
@@ -0,0 +1,922 @@
+/**
+ ********************************************
+ * @file    :CsrGraph.hpp
+ * @author  :XXY
+ * @brief   :CSR graph with tombstone pruning
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_CSR_GRAPH_HPP
+#define LSPQ_CSR_GRAPH_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include <atomic>
+#include <limits>
+
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "Parallel.hpp"
+#include "GraphStats.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+// ԳԼ
+struct SymmetryCheckOptions {
+    double tolerance = 1e-9;   // |w(i,j) - w(j,i)| ֵΪһ
+    bool stop_at_first = true; // trueҵһֹͣfalseռƫɴ
+    size_t max_report = 20;    // ռģʽ±
+    size_t threads = 0;        // 0 ʾʹȫӲ߳
+};
+
+// ֦Ľڵŷʽ֧ͨУ֧ڰȻ Cuthill-McKee ˳
+enum class NodeOrder { Bfs, ReverseCuthillMcKee };
+
+struct SymmetryViolation {
+    uint32_t row = 0;
+    uint32_t col = 0;
+    double forward = 0.0;  //  row е col еֵ
+    double backward = 0.0; //  col е row еֵȱʧʱΪ NaN
+    bool missing = false;
+
+    double difference() const {
+        return missing ? numeric_limits<double>::infinity() : abs(forward - backward);
+    }
+};
+
+struct SymmetryReport {
+    size_t checked_pairs = 0;
+    size_t violation_count = 0;           // ռģʽΪȷ״ģʽΪ 1
+    vector<SymmetryViolation> violations; // ״ģʽֻһռģʽ°ƫ
+
+    bool passed() const { return violation_count == 0; }
+};
+
+//  Graph ʽһµѹϡУCSRʵ֡
+// ڵʹ±꣬ÿ˵иһݣ
+// ֦ʱֻλͼдĹǣϣɾڴͷţ
+// ֧ͨ뵼׶ֱǵıߡ
+class CsrGraph {
+    // ݳԱ
+    vector<string> nodeIds_;
+    unordered_map<string, uint32_t> index_;
+    vector<size_t> offsets_;     // ʼλãСΪ N+1
+    vector<uint32_t> targets_;   // ߵĿڵ±꣨
+    vector<double> weights_;     // Ȩأдеԭʼֵ
+    vector<uint32_t> reverse_;   // Ŀڵڵƫ
+    vector<uint64_t> removed_;   // Ĺλͼλʾñѱ
+    vector<uint32_t> degree_;    // ÿڵ㵱ǰı
+    bool symmetric_ = false;
+    bool compacted_ = false;     // compact() ֮󱻼ı߼ԭʼȨѲ
+    bool analyzed_ = false;
+    vector<uint32_t> original_index_;  // ź󣺵ǰ± -> е±ꣻδʱΪ
+    vector<uint32_t> position_;        // źе± -> ǰ±
+    vector<size_t> component_offsets_; // źÿ֧ͨռһ±
+    bool original_order_output_ = false;
+    GraphStats stats_;           // άͳϢ
+
+    // ˽й߷
+    size_t reverse_edge(size_t edge) const {
+        return offsets_[targets_[edge]] + reverse_[edge];
+    }
+    void cut_edge(uint32_t source, size_t edge, GraphStats::Tier tier);
+    void rebuild_reverse();
+    void relabel(const vector<uint32_t>& order);
+    double mean_edge_span() const;
+    vector<vector<uint32_t>> original_order_components() const;
+
+    // ʱ p λϵĽڵڵĵλã˳򵼳ʱûΪӳ
+    bool use_original_order() const { return original_order_output_ && !original_index_.empty(); }
+    uint32_t output_node(size_t p) const { return use_original_order() ? position_[p] : static_cast<uint32_t>(p); }
+    uint32_t output_position(uint32_t node) const { return use_original_order() ? original_index_[node] : node; }
+
+public:
+    // 캯
+    explicit CsrGraph(const string& dataPath);
+
+    // ӿ
+    size_t node_count() const { return nodeIds_.size(); }
+    size_t live_edge_count() const;
+    const vector<string>& node_ids() const { return nodeIds_; }
+    uint32_t index_of(const string& id) const { return index_.at(id); }
+    bool is_removed(size_t edge) const { return (removed_[edge >> 6] >> (edge & 63)) & 1u; }
+    size_t degree(uint32_t node) const { return degree_[node]; }
+    const GraphStats& statistics() const { return stats_; }
+
+    // ڵĴھӣf(target, weight)
+    template <typename F>
+    void for_each_neighbor(uint32_t node, F&& f) const {
+        for (size_t e = offsets_[node]; e < offsets_[node + 1]; ++e) {
+            if (!is_removed(e)) f(targets_[e], weights_[e]);
+        }
+    }
+
+    // ڵڼ֦ǰȫھӣѼıߣf(target, weight)compact() ֮󲻿
+    bool has_original_weights() const { return !compacted_; }
+    template <typename F>
+    void for_each_original_neighbor(uint32_t node, F&& f) const {
+        if (compacted_) throw logic_error("compact() ֦֮ǰȨѱͷ");
+        for (size_t e = offsets_[node]; e < offsets_[node + 1]; ++e) {
+            f(targets_[e], weights_[e]);
+        }
+    }
+
+    void validate_symmetry() const;
+    SymmetryReport check_symmetry(const SymmetryCheckOptions& options) const;
+    void print_symmetry_report(const SymmetryReport& report) const;
+    void export_symmetry_report(const SymmetryReport& report, const string& output_path) const;
+    void symmetrize();
+    void print_summary() const;
+
+    void perform_neighborhood_analysis(double small_threshold, double medium_threshold,
+        double large_threshold, size_t min_neighbors);
+    void compact();
+    // Žڵ±꣬ʹÿ֧ͨĽڵڴ֧ڽڵ±Ҳ
+    // ڼ֦֮ã֦˳򣩣ŻƳĹߣ֦ǰȨ֮ͷš
+    void reorder(NodeOrder order = NodeOrder::ReverseCuthillMcKee);
+    bool is_reordered() const { return !original_index_.empty(); }
+    uint32_t original_index(uint32_t node) const { return original_index_.empty() ? node : original_index_[node]; }
+    // źĵĬϰ˳򣨷֧еָΪδʱȫͬ˳
+    void set_original_order_output(bool enabled) { original_order_output_ = enabled; }
+    int count_connected_components() const;
+    void print_neighborhood_stats() const;
+    void export_statistics_tsv(const string& output_path) const;
+    void export_statistics_json(const string& output_path) const;
+    vector<vector<uint32_t>> component_indices() const;
+    vector<vector<string>> get_connected_components() const;
+    void export_adjacency_matrix(const string& output_path) const;
+    void export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const;
+    void export_all_components_to_single_file(const string& output_file_path) const;
+    void export_all_component_adjacency_matrices_to_single_file(const string& output_file_path) const;
+};
+
+/**************** Աʵ ****************/
+
+// 캯ʵ֣жֱܾд CSR 
+CsrGraph::CsrGraph(const string& dataPath) {
+    LSPQ_PROFILE_SCOPE("CsrGraph::load");
+    MatrixInputStream file(dataPath);
+    if (!file) throw runtime_error("޷ļ: " + dataPath);
+
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) {
+        throw runtime_error("ļΪ");
+    }
+    nodeIds_.assign(reader.tokens().begin(), reader.tokens().end());
+    if (nodeIds_.empty()) {
+        throw runtime_error("ڵIDбΪ");
+    }
+
+    const size_t n = nodeIds_.size();
+    index_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        index_.emplace(nodeIds_[i], static_cast<uint32_t>(i));
+    }
+
+    // 룺ÿ N-1 ߣĿ갴˳
+    const size_t row_edges = n - 1;
+    offsets_.resize(n + 1);
+    for (size_t i = 0; i <= n; ++i) offsets_[i] = i * row_edges;
+    targets_.resize(n * row_edges);
+    weights_.resize(n * row_edges);
+    reverse_.resize(n * row_edges);
+    degree_.assign(n, static_cast<uint32_t>(row_edges));
+    stats_.reset_degrees(n, row_edges);
+    removed_.assign((n * row_edges + 63) / 64, 0);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!reader.next_row()) {
+            throw runtime_error("ȱٵ" + to_string(i + 1) + "");
+        }
+
+        if (reader.size() != n + 1) {
+            throw runtime_error("" + to_string(i + 1) + "ƥ䣬Ԥ: " +
+                to_string(n + 1) + " ʵ: " + to_string(reader.size()));
+        }
+        if (reader[0] != nodeIds_[i]) {
+            throw runtime_error("ڵIDƥ:  " + to_string(i + 1) +
+                " Ԥ " + nodeIds_[i] + " ʵ " + string(reader[0]));
+        }
+
+        size_t e = offsets_[i];
+        for (size_t j = 1; j < reader.size(); ++j) {
+            const size_t target = j - 1;
+            if (target == i) continue; // Խ
+
+            if (!MatrixRowReader::to_double(reader[j], weights_[e])) {
+                throw runtime_error("" + to_string(i + 1) + "е" +
+                    to_string(j + 1) + "ֵЧ: " + string(reader[j]));
+            }
+            targets_[e] = static_cast<uint32_t>(target);
+            // ڵ i ĿеλãĿͬԽ
+            reverse_[e] = static_cast<uint32_t>(i < target ? i : i - 1);
+            ++e;
+        }
+        LSPQ_PROFILE_COUNT("cells_parsed", reader.size() - 1);
+    }
+    LSPQ_PROFILE_COUNT("edges_inserted", targets_.size());
+
+    // ȨֱͼʵȡֵΧ䣬ٷֱȺ 0~1 Сľܵõķֲ
+    // ڵԵЧȨȡϺһеֵ targets_[e] < i һ
+    double min_weight = 0.0, max_weight = 0.0;
+    bool any = false;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t e = offsets_[i]; e < offsets_[i + 1] && targets_[e] < i; ++e) {
+            if (!any || weights_[e] < min_weight) min_weight = weights_[e];
+            if (!any || weights_[e] > max_weight) max_weight = weights_[e];
+            any = true;
+        }
+    }
+    if (any) stats_.set_weight_range(min_weight, max_weight);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t e = offsets_[i]; e < offsets_[i + 1] && targets_[e] < i; ++e) {
+            stats_.on_edge_loaded(weights_[e]);
+        }
+    }
+}
+
+size_t CsrGraph::live_edge_count() const {
+    size_t total = 0;
+    for (uint32_t d : degree_) total += d;
+    return total / 2;
+}
+
+// Գ֤ʵ֣ Graph ͬݲһһ¼׳쳣
+void CsrGraph::validate_symmetry() const {
+    SymmetryReport report = check_symmetry(SymmetryCheckOptions());
+    if (!report.passed()) {
+        const SymmetryViolation& v = report.violations.front();
+        if (v.missing) {
+            throw runtime_error("ͼԳƻ: " + nodeIds_[v.col] + " -> " + nodeIds_[v.row] + " δ洢");
+        }
+        throw runtime_error("Ȩزһ: " + nodeIds_[v.row] + " -> " + nodeIds_[v.col] + " = " +
+            to_string(v.forward) + " vs " + to_string(v.backward));
+    }
+    cout << "ͼԳ֤ͨ\n";
+}
+
+// жԳԼ飺п鶯̬䣬ÿڵֻڽС±бȽһΡ
+// ״ģʽ¸̹߳ǰСĳУֱ֮Ϻٴжλеһ
+// ˽봮ɨһ¡
+SymmetryReport CsrGraph::check_symmetry(const SymmetryCheckOptions& options) const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::check_symmetry");
+    const size_t n = nodeIds_.size();
+    const size_t workers = resolve_thread_count(options.threads);
+    const size_t keep = max<size_t>(options.max_report, 1);
+
+    atomic<size_t> first_bad_row(SIZE_MAX);
+    vector<size_t> checked(workers, 0);
+    vector<size_t> violations(workers, 0);
+    vector<vector<SymmetryViolation>> worst(workers);
+
+    // СѣѶǵǰĿƫСһ
+    auto smaller_first = [](const SymmetryViolation& a, const SymmetryViolation& b) {
+        return a.difference() > b.difference();
+    };
+
+    auto inspect = [&](uint32_t u, size_t e) {
+        const size_t r = reverse_edge(e);
+        SymmetryViolation v;
+        v.row = u;
+        v.col = targets_[e];
+        v.forward = weights_[e];
+        v.missing = targets_[r] != u;
+        v.backward = v.missing ? numeric_limits<double>::quiet_NaN() : weights_[r];
+        return v;
+    };
+
+    parallel_for_blocks(n, 64, options.threads, [&](size_t begin, size_t end, size_t worker) {
+        for (size_t i = begin; i < end; ++i) {
+            if (options.stop_at_first && i > first_bad_row.load(memory_order_relaxed)) return;
+
+            const uint32_t u = static_cast<uint32_t>(i);
+            const auto row_begin = targets_.begin() + offsets_[u];
+            const auto row_end = targets_.begin() + offsets_[u + 1];
+            for (size_t e = upper_bound(row_begin, row_end, u) - targets_.begin(); e < offsets_[u + 1]; ++e) {
+                ++checked[worker];
+                SymmetryViolation v = inspect(u, e);
+                if (!(v.difference() > options.tolerance)) continue;
+
+                ++violations[worker];
+                if (options.stop_at_first) {
+                    size_t current = first_bad_row.load();
+                    while (i < current && !first_bad_row.compare_exchange_weak(current, i)) {}
+                    break;
+                }
+
+                auto& heap = worst[worker];
+                if (heap.size() < keep) {
+                    heap.push_back(v);
+                    push_heap(heap.begin(), heap.end(), smaller_first);
+                }
+                else if (v.difference() > heap.front().difference()) {
+                    pop_heap(heap.begin(), heap.end(), smaller_first);
+                    heap.back() = v;
+                    push_heap(heap.begin(), heap.end(), smaller_first);
+                }
+            }
+        }
+    });
+
+    SymmetryReport report;
+    for (size_t w = 0; w < workers; ++w) {
+        report.checked_pairs += checked[w];
+        report.violation_count += violations[w];
+    }
+
+    if (options.stop_at_first) {
+        const size_t row = first_bad_row.load();
+        if (row != SIZE_MAX) {
+            const uint32_t u = static_cast<uint32_t>(row);
+            const auto row_begin = targets_.begin() + offsets_[u];
+            const auto row_end = targets_.begin() + offsets_[u + 1];
+            for (size_t e = upper_bound(row_begin, row_end, u) - targets_.begin(); e < offsets_[u + 1]; ++e) {
+                SymmetryViolation v = inspect(u, e);
+                if (v.difference() > options.tolerance) {
+                    report.violations.push_back(v);
+                    break;
+                }
+            }
+        }
+        return report;
+    }
+
+    for (auto& heap : worst) {
+        report.violations.insert(report.violations.end(), heap.begin(), heap.end());
+    }
+    sort(report.violations.begin(), report.violations.end(),
+        [](const SymmetryViolation& a, const SymmetryViolation& b) {
+            if (a.difference() != b.difference()) return a.difference() > b.difference();
+            return a.row != b.row ? a.row < b.row : a.col < b.col;
+        });
+    if (report.violations.size() > keep) report.violations.resize(keep);
+    return report;
+}
+
+void CsrGraph::print_symmetry_report(const SymmetryReport& report) const {
+    cout << "ԳԼ: ȽϽڵ " << report.checked_pairs
+        << "һ " << report.violation_count << " \n";
+    for (const auto& v : report.violations) {
+        cout << "  " << nodeIds_[v.row] << " <-> " << nodeIds_[v.col] << ": "
+            << v.forward << " vs ";
+        if (v.missing) cout << "δ洢\n";
+        else cout << v.backward << "\n";
+    }
+}
+
+// ԳϸTSVڼȶԹ߲΢Գ
+void CsrGraph::export_symmetry_report(const SymmetryReport& report, const string& output_path) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "RowNode\tColumnNode\tRowValue\tColumnValue\tAbsDifference\n";
+    for (const auto& v : report.violations) {
+        outfile << nodeIds_[v.row] << "\t" << nodeIds_[v.col] << "\t" << v.forward << "\t";
+        if (v.missing) {
+            outfile << "NA\tNA\n";
+        }
+        else {
+            outfile << v.backward << "\t" << v.difference() << "\n";
+        }
+    }
+
+    outfile.close();
+    cout << "ԳԼ鱨ѵ: " << output_path << endl;
+}
+
+// Գƻ Graph 캯ĸ˳һ£ڵ (i, j) ȡϺһеֵ
+void CsrGraph::symmetrize() {
+    if (symmetric_) return;
+    LSPQ_PROFILE_SCOPE("CsrGraph::symmetrize");
+    for (uint32_t i = 0; i < nodeIds_.size(); ++i) {
+        for (size_t e = offsets_[i]; e < offsets_[i + 1]; ++e) {
+            if (targets_[e] > i) weights_[e] = weights_[reverse_edge(e)];
+        }
+    }
+    symmetric_ = true;
+}
+
+// ժҪӡʵ
+void CsrGraph::print_summary() const {
+    cout << "ͼ\n";
+    cout << "ڵ: " << nodeIds_.size() << endl;
+}
+
+// һߣͬʱĹO(1) Ҳͷڴ
+void CsrGraph::cut_edge(uint32_t source, size_t edge, GraphStats::Tier tier) {
+    const size_t r = reverse_edge(edge);
+    stats_.on_edge_cut(degree_[source], degree_[targets_[edge]], weights_[edge], tier);
+    removed_[edge >> 6] |= uint64_t(1) << (edge & 63);
+    removed_[r >> 6] |= uint64_t(1) << (r & 63);
+    --degree_[source];
+    --degree_[targets_[edge]];
+}
+
+// ֵּ֦ж Graph::perform_neighborhood_analysis ȫͬ
+void CsrGraph::perform_neighborhood_analysis(double small_threshold, double medium_threshold,
+    double large_threshold, size_t min_neighbors) {
+    LSPQ_PROFILE_SCOPE("CsrGraph::perform_neighborhood_analysis");
+    cout << "ʼ...\n";
+    cout << "ֵ: =" << small_threshold << ", =" << medium_threshold
+        << ", С=" << large_threshold << "\n";
+    cout << "ھԼ: =" << min_neighbors << "\n";
+
+    if (is_reordered()) {
+        throw logic_error("ڵţ֦밴˳У֮ǰ");
+    }
+    symmetrize();
+    stats_.begin_pruning();
+
+    int nodes_processed = 0;
+    int small_threshold_cuts = 0;
+    int medium_threshold_cuts = 0;
+    int large_threshold_cuts = 0;
+    int skipped_nodes = 0;
+    size_t edges_cut = 0;
+
+    for (uint32_t u = 0; u < nodeIds_.size(); ++u) {
+        const size_t live = degree_[u];
+        if (live <= min_neighbors) {
+            skipped_nodes++;
+            stats_.on_node_skipped();
+            continue;
+        }
+
+        // һɨͬʱͳֵı
+        size_t below_small = 0, below_medium = 0, below_large = 0;
+        for (size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+            if (is_removed(e)) continue;
+            const double w = weights_[e];
+            below_small += w < small_threshold;
+            below_medium += w < medium_threshold;
+            below_large += w < large_threshold;
+        }
+
+        double threshold;
+        GraphStats::Tier tier;
+        if (live - below_small >= min_neighbors) {
+            threshold = small_threshold;
+            tier = GraphStats::kSmallTier;
+            small_threshold_cuts++;
+        }
+        else if (live - below_medium >= min_neighbors) {
+            threshold = medium_threshold;
+            tier = GraphStats::kMediumTier;
+            medium_threshold_cuts++;
+        }
+        else {
+            threshold = large_threshold;
+            tier = GraphStats::kLargeTier;
+            large_threshold_cuts++;
+        }
+        nodes_processed++;
+        stats_.on_node_tier(tier);
+
+        for (size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+            if (!is_removed(e) && weights_[e] < threshold) {
+                cut_edge(u, e, tier);
+                ++edges_cut;
+            }
+        }
+    }
+
+    LSPQ_PROFILE_COUNT("edges_cut", edges_cut);
+    analyzed_ = true;
+
+    cout << ":\n";
+    cout << "ڵ: " << nodes_processed << "\n";
+    cout << "ڵ: " << skipped_nodes << "\n";
+    cout << "Сֵи: " << small_threshold_cuts << "\n";
+    cout << "ֵи: " << medium_threshold_cuts << "\n";
+    cout << "ֵи: " << large_threshold_cuts << "\n";
+
+    int components = count_connected_components();
+    cout << "֧ͨ: " << components << "\n";
+}
+
+// ѹ֦һƳĹߣؽƫƺͷ
+void CsrGraph::compact() {
+    LSPQ_PROFILE_SCOPE("CsrGraph::compact");
+    size_t write = 0;
+    size_t row_start = 0;
+    for (uint32_t u = 0; u < nodeIds_.size(); ++u) {
+        const size_t row_end = offsets_[u + 1];
+        for (size_t e = row_start; e < row_end; ++e) {
+            if (is_removed(e)) continue;
+            targets_[write] = targets_[e];
+            weights_[write] = weights_[e];
+            ++write;
+        }
+        row_start = row_end;
+        offsets_[u + 1] = write;
+    }
+    targets_.resize(write);
+    targets_.shrink_to_fit();
+    weights_.resize(write);
+    weights_.shrink_to_fit();
+    removed_.assign((write + 63) / 64, 0);
+    removed_.shrink_to_fit();
+    compacted_ = true;
+    rebuild_reverse();
+}
+
+// ĿͼԳƣԴڵɨ輴˳ÿߵλ
+void CsrGraph::rebuild_reverse() {
+    reverse_.assign(targets_.size(), 0);
+    reverse_.shrink_to_fit();
+    vector<uint32_t> cursor(nodeIds_.size(), 0);
+    for (uint32_t u = 0; u < nodeIds_.size(); ++u) {
+        for (size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+            reverse_[e] = cursor[targets_[e]]++;
+        }
+    }
+}
+
+// ±֮ƽֵھӷʵĿ
+double CsrGraph::mean_edge_span() const {
+    double total = 0.0;
+    size_t edges = 0;
+    for (uint32_t u = 0; u < nodeIds_.size(); ++u) {
+        for_each_neighbor(u, [&](uint32_t v, double) {
+            total += u > v ? u - v : v - u;
+            ++edges;
+        });
+    }
+    return edges ? total / edges : 0.0;
+}
+
+//  order± -> ±꣩ؽֻߵ CSRۻ˳û
+void CsrGraph::relabel(const vector<uint32_t>& order) {
+    const size_t n = nodeIds_.size();
+    vector<uint32_t> inverse(n);
+    for (uint32_t u = 0; u < n; ++u) inverse[order[u]] = u;
+
+    vector<size_t> offsets(n + 1, 0);
+    vector<uint32_t> targets;
+    vector<double> weights;
+    targets.reserve(live_edge_count() * 2);
+    weights.reserve(live_edge_count() * 2);
+    vector<pair<uint32_t, double>> row;
+    for (uint32_t u = 0; u < n; ++u) {
+        row.clear();
+        for_each_neighbor(order[u], [&](uint32_t v, double w) { row.emplace_back(inverse[v], w); });
+        sort(row.begin(), row.end());
+        for (const auto& edge : row) {
+            targets.push_back(edge.first);
+            weights.push_back(edge.second);
+        }
+        offsets[u + 1] = targets.size();
+    }
+
+    vector<string> ids(n);
+    vector<uint32_t> degree(n);
+    vector<uint32_t> original(n);
+    for (uint32_t u = 0; u < n; ++u) {
+        ids[u] = move(nodeIds_[order[u]]);
+        degree[u] = degree_[order[u]];
+        original[u] = original_index(order[u]);
+    }
+    nodeIds_ = move(ids);
+    degree_ = move(degree);
+    original_index_ = move(original);
+    position_.assign(n, 0);
+    for (uint32_t u = 0; u < n; ++u) position_[original_index_[u]] = u;
+    for (uint32_t u = 0; u < n; ++u) index_[nodeIds_[u]] = u;
+
+    offsets_ = move(offsets);
+    targets_ = move(targets);
+    weights_ = move(weights);
+    removed_.assign((targets_.size() + 63) / 64, 0);
+    compacted_ = true;
+    rebuild_reverse();
+}
+
+void CsrGraph::reorder(NodeOrder order) {
+    LSPQ_PROFILE_SCOPE("CsrGraph::reorder");
+    if (!analyzed_) {
+        throw logic_error("reorder()  perform_neighborhood_analysis ֮");
+    }
+    const size_t n = nodeIds_.size();
+    const double span_before = mean_edge_span();
+
+    // ֧˳򲻱䣻֧ڴȣRCM ӶСĽڵھӰӣηת
+    const bool rcm = order == NodeOrder::ReverseCuthillMcKee;
+    vector<uint32_t> permutation;
+    permutation.reserve(n);
+    vector<size_t> component_offsets(1, 0);
+    vector<char> placed(n, 0);
+    vector<uint32_t> frontier;
+    for (const auto& component : component_indices()) {
+        const size_t begin = permutation.size();
+        uint32_t start = component.front();
+        if (rcm) {
+            for (uint32_t node : component) {
+                if (degree_[node] < degree_[start] || (degree_[node] == degree_[start] && node < start)) start = node;
+            }
+        }
+        placed[start] = 1;
+        permutation.push_back(start);
+        for (size_t head = begin; head < permutation.size(); ++head) {
+            frontier.clear();
+            for_each_neighbor(permutation[head], [&](uint32_t v, double) {
+                if (!placed[v]) {
+                    placed[v] = 1;
+                    frontier.push_back(v);
+                }
+            });
+            if (rcm) {
+                sort(frontier.begin(), frontier.end(), [this](uint32_t a, uint32_t b) {
+                    return degree_[a] != degree_[b] ? degree_[a] < degree_[b] : a < b;
+                });
+            }
+            permutation.insert(permutation.end(), frontier.begin(), frontier.end());
+        }
+        if (rcm) reverse(permutation.begin() + begin, permutation.end());
+        component_offsets.push_back(permutation.size());
+    }
+
+    relabel(permutation);
+    component_offsets_ = move(component_offsets);
+
+    cout << "ڵɣ" << (rcm ? "RCM" : "BFS") << ": " << (component_offsets_.size() - 1)
+        << " ֧ͨռ±꣬ƽ " << span_before << " -> " << mean_edge_span() << "\n";
+}
+
+// ֧ͨ
+int CsrGraph::count_connected_components() const {
+    return static_cast<int>(component_indices().size());
+}
+
+// Խڵ±ʾ֧ͨʽջģݹ DFSڵ˳Ϊ
+vector<vector<uint32_t>> CsrGraph::component_indices() const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::connected_components");
+    if (use_original_order()) return original_order_components();
+    if (!component_offsets_.empty()) {
+        // źÿ֧һ±ֱ꣬з
+        vector<vector<uint32_t>> all_components;
+        for (size_t c = 0; c + 1 < component_offsets_.size(); ++c) {
+            vector<uint32_t> component(component_offsets_[c + 1] - component_offsets_[c]);
+            for (size_t k = 0; k < component.size(); ++k) {
+                component[k] = static_cast<uint32_t>(component_offsets_[c] + k);
+            }
+            all_components.push_back(move(component));
+        }
+        return all_components;
+    }
+
+    const size_t n = nodeIds_.size();
+    vector<vector<uint32_t>> all_components;
+    vector<char> visited(n, 0);
+    vector<pair<uint32_t, size_t>> stack;
+
+    for (uint32_t start = 0; start < n; ++start) {
+        if (visited[start]) continue;
+
+        vector<uint32_t> component;
+        visited[start] = 1;
+        component.push_back(start);
+        stack.emplace_back(start, offsets_[start]);
+
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            const uint32_t node = frame.first;
+            size_t& e = frame.second;
+            while (e < offsets_[node + 1] && (is_removed(e) || visited[targets_[e]])) ++e;
+            if (e == offsets_[node + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            const uint32_t next = targets_[e++];
+            visited[next] = 1;
+            component.push_back(next);
+            stack.emplace_back(next, offsets_[next]);
+        }
+        all_components.push_back(move(component));
+    }
+    return all_components;
+}
+
+// ˳֧ͨ±ؽڽӱͬ DFSδʱͬ
+vector<vector<uint32_t>> CsrGraph::original_order_components() const {
+    const size_t n = nodeIds_.size();
+    vector<size_t> offsets(n + 1, 0);
+    vector<uint32_t> targets;
+    for (uint32_t p = 0; p < n; ++p) {
+        for_each_neighbor(position_[p], [&](uint32_t v, double) { targets.push_back(original_index_[v]); });
+        sort(targets.begin() + offsets[p], targets.end());
+        offsets[p + 1] = targets.size();
+    }
+
+    vector<vector<uint32_t>> all_components;
+    vector<char> visited(n, 0);
+    vector<pair<uint32_t, size_t>> stack;
+    for (uint32_t start = 0; start < n; ++start) {
+        if (visited[start]) continue;
+
+        vector<uint32_t> component;
+        visited[start] = 1;
+        component.push_back(position_[start]);
+        stack.emplace_back(start, offsets[start]);
+
+        while (!stack.empty()) {
+            auto& frame = stack.back();
+            const uint32_t node = frame.first;
+            size_t& e = frame.second;
+            while (e < offsets[node + 1] && visited[targets[e]]) ++e;
+            if (e == offsets[node + 1]) {
+                stack.pop_back();
+                continue;
+            }
+            const uint32_t next = targets[e++];
+            visited[next] = 1;
+            component.push_back(position_[next]);
+            stack.emplace_back(next, offsets[next]);
+        }
+        all_components.push_back(move(component));
+    }
+    return all_components;
+}
+
+vector<vector<string>> CsrGraph::get_connected_components() const {
+    vector<vector<string>> all_components;
+    for (const auto& component : component_indices()) {
+        vector<string> names;
+        names.reserve(component.size());
+        for (uint32_t node : component) names.push_back(nodeIds_[node]);
+        all_components.push_back(move(names));
+    }
+    return all_components;
+}
+
+// ӡھͳϢֱӶȡάĶֱͼ
+void CsrGraph::print_neighborhood_stats() const {
+    cout << "ھͳϢ:\n";
+    cout << "Сھ: " << stats_.min_degree() << "\n";
+    cout << "ھ: " << stats_.max_degree() << "\n";
+    cout << "ƽھ: " << stats_.mean_degree() << "\n";
+}
+
+// ֱͼٷλȨֱͼ֧ͨСֲ
+void CsrGraph::export_statistics_tsv(const string& output_path) const {
+    vector<size_t> sizes;
+    for (const auto& component : component_indices()) sizes.push_back(component.size());
+    stats_.export_tsv(output_path, sizes);
+}
+
+void CsrGraph::export_statistics_json(const string& output_path) const {
+    vector<size_t> sizes;
+    for (const auto& component : component_indices()) sizes.push_back(component.size());
+    stats_.export_json(output_path, sizes);
+}
+
+// ڽӾÿַбǴھӣд
+void CsrGraph::export_adjacency_matrix(const string& output_path) const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::export_adjacency_matrix");
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    const size_t n = nodeIds_.size();
+    outfile << "\t";
+    for (size_t i = 0; i < n; ++i) {
+        outfile << nodeIds_[output_node(i)] << (i == n - 1 ? "" : "\t");
+    }
+    outfile << "\n";
+
+    // ÿԪռֵַ + ƱĩƱ滻Ϊ
+    string row(2 * n, '\t');
+    for (size_t p = 0; p < n; ++p) {
+        const uint32_t u = output_node(p);
+        for (size_t i = 0; i < n; ++i) row[2 * i] = '0';
+        row[2 * p] = '-';
+        for_each_neighbor(u, [&](uint32_t v, double) { row[2 * output_position(v)] = '1'; });
+        row[2 * n - 1] = '\n';
+        outfile << nodeIds_[u] << "\t";
+        outfile.write(row.data(), row.size());
+    }
+
+    outfile.close();
+    cout << "ڽӾѵ: " << output_path << endl;
+}
+
+//  Cytoscape бڵ±˳ÿֻдһΣԴIDֵС
+void CsrGraph::export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::export_edge_list_for_cytoscape");
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "SourceNode\tTargetNode\tInteractionType\tWeight\n";
+
+    // ˳򵼳ʱھҲ±
+    vector<pair<uint32_t, uint32_t>> neighbors;
+    for (size_t p = 0; p < nodeIds_.size(); ++p) {
+        const uint32_t u = output_node(p);
+        const string& source_node = nodeIds_[u];
+        neighbors.clear();
+        for (size_t e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+            if (!is_removed(e)) neighbors.emplace_back(output_position(targets_[e]), static_cast<uint32_t>(e - offsets_[u]));
+        }
+        if (use_original_order()) sort(neighbors.begin(), neighbors.end());
+        for (const auto& neighbor : neighbors) {
+            const size_t e = offsets_[u] + neighbor.second;
+            const string& target_node = nodeIds_[targets_[e]];
+            if (source_node < target_node) {
+                outfile << source_node << "\t"
+                    << target_node << "\t"
+                    << interaction_type << "\t"
+                    << weights_[e] << "\n";
+            }
+        }
+    }
+
+    outfile.close();
+    cout << "Cytoscape б (Ȩ) ѵ: " << output_path << endl;
+}
+
+void CsrGraph::export_all_components_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::export_all_components_to_single_file");
+    vector<vector<uint32_t>> components = component_indices();
+
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    cout << " " << components.size() << " ֧ͨڵļ: " << output_file_path << endl;
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        const auto& component_nodes = components[i];
+        outfile << "Component " << (i + 1) << " (Nodes: " << component_nodes.size() << "):\n";
+        for (uint32_t node : component_nodes) {
+            outfile << nodeIds_[node] << "\n";
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "֧ͨѵ: " << output_file_path << endl;
+}
+
+void CsrGraph::export_all_component_adjacency_matrices_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("CsrGraph::export_all_component_adjacency_matrices_to_single_file");
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    vector<vector<uint32_t>> components = component_indices();
+    cout << " " << components.size() << " ֧ͨڵڽӾ: " << output_file_path << endl;
+
+    // ȫ± -> ֧кţ֧
+    vector<uint32_t> local(nodeIds_.size(), UINT32_MAX);
+    string row;
+    for (size_t i = 0; i < components.size(); ++i) {
+        const auto& component_nodes = components[i];
+        const size_t k = component_nodes.size();
+        for (size_t j = 0; j < k; ++j) local[component_nodes[j]] = static_cast<uint32_t>(j);
+
+        outfile << "Component " << (i + 1) << " Adjacency Matrix (Nodes: " << k << "):\n";
+
+        outfile << "\t";
+        for (size_t j = 0; j < k; ++j) {
+            outfile << nodeIds_[component_nodes[j]] << (j == k - 1 ? "" : "\t");
+        }
+        outfile << "\n";
+
+        row.assign(2 * k, '\t');
+        for (size_t r = 0; r < k; ++r) {
+            const uint32_t u = component_nodes[r];
+            for (size_t j = 0; j < k; ++j) row[2 * j] = '0';
+            row[2 * r] = '-';
+            for_each_neighbor(u, [&](uint32_t v, double) { row[2 * local[v]] = '1'; });
+            row[2 * k - 1] = '\n';
+            outfile << nodeIds_[u] << "\t";
+            outfile.write(row.data(), row.size());
+        }
+        outfile << "\n";
+
+        for (uint32_t node : component_nodes) local[node] = UINT32_MAX;
+    }
+
+    outfile.close();
+    cout << "֧ͨڽӾѵ: " << output_file_path << endl;
+}
+
+#endif // LSPQ_CSR_GRAPH_HPP
@@ -0,0 +1,198 @@
+/**
+ ********************************************
+ * @file    :ExternalSort.hpp
+ * @author  :XXY
+ * @brief   :Bounded-memory sorter that spills sorted runs to disk
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_EXTERNAL_SORT_HPP
+#define LSPQ_EXTERNAL_SORT_HPP
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+
+using namespace std;
+
+// 򣺼¼ȷŽڴ滺ʱΪһдʱļ
+// finish() ֮ next() ڴеʣಿ k ·鲢rewind() ¹鲢
+// ¼ǿƽƵͣԭʼֽд̡
+template <typename Record, typename Less = less<Record>>
+class ExternalSorter {
+    static_assert(is_trivially_copyable<Record>::value, "Record ƽ");
+
+    static constexpr size_t kReadBlock = 4096;  // 鲢ʱÿһζļ¼
+
+    struct Run {
+        string path;
+        size_t records = 0;
+    };
+
+    struct Cursor {
+        ifstream in;
+        vector<Record> block;
+        size_t position = 0;
+        size_t remaining = 0;  // ļδļ¼
+        const Record* memory_end = nullptr;
+        const Record* memory = nullptr;  // ڴе
+    };
+
+    string directory_;
+    size_t capacity_;
+    Less less_;
+    vector<Record> buffer_;
+    vector<Run> runs_;
+    size_t size_ = 0;
+    bool finished_ = false;
+
+    vector<unique_ptr<Cursor>> cursors_;
+    vector<size_t> heap_;
+
+    void spill();
+    bool advance(Cursor& cursor) const;
+    const Record& current(const Cursor& cursor) const {
+        return cursor.memory ? *cursor.memory : cursor.block[cursor.position];
+    }
+
+public:
+    // capacity Ϊڴ滺ɵļ¼directory ΪεĿ¼Ѵڣ
+    ExternalSorter(const string& directory, size_t capacity, Less less = Less());
+    ~ExternalSorter();
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    void push(const Record& record);
+    void finish();
+    void rewind();
+    bool next(Record& record);
+
+    size_t size() const { return size_; }
+    size_t run_count() const { return runs_.size(); }
+    size_t memory_bytes() const { return buffer_.capacity() * sizeof(Record); }
+};
+
+/**************** Աʵ ****************/
+
+template <typename Record, typename Less>
+ExternalSorter<Record, Less>::ExternalSorter(const string& directory, size_t capacity, Less less)
+    : directory_(directory), capacity_(max<size_t>(capacity, 1)), less_(less) {
+}
+
+template <typename Record, typename Less>
+ExternalSorter<Record, Less>::~ExternalSorter() {
+    cursors_.clear();
+    for (const auto& run : runs_) {
+        error_code ignored;
+        filesystem::remove(run.path, ignored);
+    }
+}
+
+template <typename Record, typename Less>
+void ExternalSorter<Record, Less>::push(const Record& record) {
+    if (finished_) throw logic_error("ExternalSorter: finish() ֮д");
+    if (buffer_.empty()) buffer_.reserve(min<size_t>(capacity_, 1 << 16));
+    buffer_.push_back(record);
+    ++size_;
+    if (buffer_.size() >= capacity_) spill();
+}
+
+template <typename Record, typename Less>
+void ExternalSorter<Record, Less>::spill() {
+    sort(buffer_.begin(), buffer_.end(), less_);
+
+    Run run;
+    run.path = (filesystem::path(directory_) /
+        ("run_" + to_string(reinterpret_cast<uintptr_t>(this)) + "_" + to_string(runs_.size()) + ".bin")).string();
+    run.records = buffer_.size();
+
+    ofstream out(run.path, ios::binary);
+    if (!out.is_open()) throw runtime_error("޷ʱļ: " + run.path);
+    out.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size() * sizeof(Record));
+    out.close();
+    if (!out) throw runtime_error("дʱļʧ: " + run.path);
+
+    runs_.push_back(run);
+    buffer_.clear();
+}
+
+template <typename Record, typename Less>
+void ExternalSorter<Record, Less>::finish() {
+    if (finished_) return;
+    sort(buffer_.begin(), buffer_.end(), less_);
+    finished_ = true;
+    rewind();
+}
+
+template <typename Record, typename Less>
+bool ExternalSorter<Record, Less>::advance(Cursor& cursor) const {
+    if (cursor.memory) {
+        return ++cursor.memory != cursor.memory_end;
+    }
+    if (++cursor.position < cursor.block.size()) return true;
+    if (cursor.remaining == 0) return false;
+
+    const size_t count = min(cursor.remaining, kReadBlock);
+    cursor.block.resize(count);
+    cursor.in.read(reinterpret_cast<char*>(cursor.block.data()), count * sizeof(Record));
+    if (!cursor.in) throw runtime_error("ȡʱļʧ");
+    cursor.remaining -= count;
+    cursor.position = 0;
+    return true;
+}
+
+template <typename Record, typename Less>
+void ExternalSorter<Record, Less>::rewind() {
+    if (!finished_) throw logic_error("ExternalSorter: Ҫȵ finish()");
+    cursors_.clear();
+    heap_.clear();
+
+    for (const auto& run : runs_) {
+        auto cursor = make_unique<Cursor>();
+        cursor->in.open(run.path, ios::binary);
+        if (!cursor->in.is_open()) throw runtime_error("޷ʱļ: " + run.path);
+        cursor->remaining = run.records;
+        cursor->position = 0;
+        if (advance(*cursor)) cursors_.push_back(move(cursor));
+    }
+    if (!buffer_.empty()) {
+        auto cursor = make_unique<Cursor>();
+        cursor->memory = buffer_.data();
+        cursor->memory_end = buffer_.data() + buffer_.size();
+        cursors_.push_back(move(cursor));
+    }
+
+    // СѣѶΪǰ¼С
+    auto greater_cursor = [this](size_t a, size_t b) { return less_(current(*cursors_[b]), current(*cursors_[a])); };
+    for (size_t i = 0; i < cursors_.size(); ++i) {
+        heap_.push_back(i);
+        push_heap(heap_.begin(), heap_.end(), greater_cursor);
+    }
+}
+
+template <typename Record, typename Less>
+bool ExternalSorter<Record, Less>::next(Record& record) {
+    if (heap_.empty()) return false;
+    auto greater_cursor = [this](size_t a, size_t b) { return less_(current(*cursors_[b]), current(*cursors_[a])); };
+
+    pop_heap(heap_.begin(), heap_.end(), greater_cursor);
+    const size_t top = heap_.back();
+    record = current(*cursors_[top]);
+    if (advance(*cursors_[top])) {
+        push_heap(heap_.begin(), heap_.end(), greater_cursor);
+    }
+    else {
+        heap_.pop_back();
+    }
+    return true;
+}
+
+#endif // LSPQ_EXTERNAL_SORT_HPP
@@ -20,29 +20,59 @@
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "GraphStats.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
 
 using namespace std;
 
 class Graph {
+    // ڵIDͬһڴԴ䣬ڴģʽ¼Ϊ
+    using Key = pmr::string;
+
     struct Vertex {
-        unordered_map<string, double> edges;
+        using allocator_type = pmr::polymorphic_allocator<char>;
+        pmr::unordered_map<Key, double> edges;
+
+        explicit Vertex(const allocator_type& alloc = {}) : edges(alloc) {}
+        Vertex(const Vertex& other, const allocator_type& alloc) : edges(other.edges, alloc) {}
+        Vertex(Vertex&& other, const allocator_type& alloc) : edges(move(other.edges), alloc) {}
     };
 
+    // ڴԴ֮ǰ֤ʱȻЧ
+    unique_ptr<pmr::monotonic_buffer_resource> arena_;
+    CountingResource memory_;
+
     // ݳԱ
-    unordered_map<string, Vertex> vertices_;
-    vector<string> nodeIds_;
+    pmr::unordered_map<Key, Vertex> vertices_;
+    pmr::vector<Key> nodeIds_;
+    GraphStats stats_;           //  CsrGraph ͬͳϢ
 
     // ˽й߷
-    vector<string> parse_line(const string& line, char delimiter);
+    vector<vector<Key>> component_keys() const;
+    void record_loaded_weights();
+    void cut_edge(Vertex& node, const Key& nodeId, const Key& target, GraphStats::Tier tier);
 
-    void find_component_nodes_dfs(const string& current_node, unordered_map<string, bool>& visited, vector<string>& component_nodes) const; // New private helper
+    void find_component_nodes_dfs(const Key& current_node, unordered_map<Key, bool>& visited, vector<Key>& component_nodes) const; // New private helper
 
 public:
     // 캯
-    explicit Graph(const string& dataPath);
+    // use_arena Ϊ true ʱͼṹӵڴط䣬غڵ malloc/free
+    explicit Graph(const string& dataPath, bool use_arena = false);
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
 
     // ӿ
-    const unordered_map<string, double>& neighbors(const string& id) const;
+    // ԭӿͬı׼ͣڲΪ pmr ֻܷظ
+    unordered_map<string, double> neighbors(const string& id) const;
+    // ֱӷڲãƣڵʱʹ
+    const pmr::unordered_map<pmr::string, double>& neighbor_edges(const string& id) const;
     void validate_symmetry() const;
     void print_summary() const;
 
@@ -51,6 +81,9 @@ public:
         double large_threshold, size_t min_neighbors);
     int count_connected_components() const;
     void print_neighborhood_stats() const;
+    const GraphStats& statistics() const { return stats_; }
+    void export_statistics_tsv(const string& output_path) const;
+    void export_statistics_json(const string& output_path) const;
     void export_adjacency_matrix(const string& output_path) const; // 
     void export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const;
     vector<vector<string>> get_connected_components() const;
@@ -61,98 +94,142 @@ public:
 /**************** Աʵ ****************/
 
 // 캯ʵ
-Graph::Graph(const string& dataPath) {
-    ifstream file(dataPath);
+Graph::Graph(const string& dataPath, bool use_arena)
+    : arena_(use_arena ? make_unique<pmr::monotonic_buffer_resource>(size_t(1) << 20) : nullptr),
+    memory_(use_arena ? static_cast<pmr::memory_resource*>(arena_.get()) : pmr::new_delete_resource()),
+    vertices_(&memory_),
+    nodeIds_(&memory_) {
+    LSPQ_PROFILE_SCOPE("Graph::load");
+    MatrixInputStream file(dataPath);
     if (!file) throw runtime_error("޷ļ: " + dataPath);
 
     // ȡһУڵID
-    string headerLine;
-    if (!getline(file, headerLine)) {
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) {
         throw runtime_error("ļΪ");
     }
-    nodeIds_ = parse_line(headerLine, '\t');
+    nodeIds_.reserve(reader.size());
+    for (string_view id : reader.tokens()) {
+        nodeIds_.emplace_back(id);
+    }
     if (nodeIds_.empty()) {
         throw runtime_error("ڵIDбΪ");
     }
 
-    // ʼͼṹ
+    // ʼͼṹԤͰ߲ʱ rehashÿжӦĶ
+    vector<Vertex*> slots;
+    slots.reserve(nodeIds_.size());
     for (const auto& id : nodeIds_) {
-        vertices_.emplace(id, Vertex());
+        Vertex& vertex = vertices_.emplace(id, Vertex()).first->second;
+        vertex.edges.reserve(nodeIds_.size() - 1);
+        slots.push_back(&vertex);
     }
 
     // 
     for (size_t i = 0; i < nodeIds_.size(); ++i) {
-        string dataLine;
-        if (!getline(file, dataLine)) {
+        if (!reader.next_row()) {
             throw runtime_error("ȱٵ" + to_string(i + 1) + "");
         }
 
         // 
-        vector<string> values = parse_line(dataLine, '\t');
-        if (values.size() != nodeIds_.size() + 1) {
+        if (reader.size() != nodeIds_.size() + 1) {
             throw runtime_error("" + to_string(i + 1) + "ƥ䣬Ԥ: " +
-                to_string(nodeIds_.size() + 1) + " ʵ: " + to_string(values.size()));
+                to_string(nodeIds_.size() + 1) + " ʵ: " + to_string(reader.size()));
         }
 
         // ֤ID
-        if (values[0] != nodeIds_[i]) {
+        if (reader[0] != string_view(nodeIds_[i])) {
             throw runtime_error("ڵIDƥ:  " + to_string(i + 1) +
-                " Ԥ " + nodeIds_[i] + " ʵ " + values[0]);
+                " Ԥ " + string(nodeIds_[i]) + " ʵ " + string(reader[0]));
         }
 
         // ƶֵ
-        for (size_t j = 1; j < values.size(); ++j) {
-            string targetId = nodeIds_[j - 1];
+        for (size_t j = 1; j < reader.size(); ++j) {
+            const Key& targetId = nodeIds_[j - 1];
             if (targetId == nodeIds_[i]) continue; // Խ
 
-            try {
-                double weight = stod(values[j]);
-                vertices_[nodeIds_[i]].edges[targetId] = weight;
-                vertices_[targetId].edges[nodeIds_[i]] = weight;
-            }
-            catch (const invalid_argument& e) {
+            double weight;
+            if (!MatrixRowReader::to_double(reader[j], weight)) {
                 throw runtime_error("" + to_string(i + 1) + "е" +
-                    to_string(j + 1) + "ֵЧ: " + values[j]);
+                    to_string(j + 1) + "ֵЧ: " + string(reader[j]));
             }
+            slots[i]->edges[targetId] = weight;
+            slots[j - 1]->edges[nodeIds_[i]] = weight;
         }
+        LSPQ_PROFILE_COUNT("cells_parsed", reader.size() - 1);
     }
+    LSPQ_PROFILE_COUNT("edges_inserted", nodeIds_.size() * (nodeIds_.size() - 1));
+    stats_.reset_degrees(nodeIds_.size(), nodeIds_.size() - 1);
+    record_loaded_weights();
+
+    // ͼṹռõڴ棬ʽھֲӰ cout ״̬
+    ostringstream report;
+    report << fixed << setprecision(1)
+        << "ͼṹڴռ: " << memory_.bytes_in_use() / (1024.0 * 1024.0) << " MB"
+        << ": " << memory_.allocations()
+        << (arena_ ? "ڴģʽ" : "") << "\n";
+    cout << report.str();
 }
 
-// нʵ
-vector<string> Graph::parse_line(const string& line, char delimiter) {
-    vector<string> tokens;
-    istringstream ss(line);
-    string token;
-    while (getline(ss, token, delimiter)) {
-        // ȥβո
-        token.erase(remove_if(token.begin(), token.end(), ::isspace), token.end());
-        if (!token.empty()) {
-            tokens.push_back(token);
+// ɺÿڵԵȨͬΪϺһеֵֻ ID Сһ¼һΡ
+// ȡֵΧٷ䣬 CsrGraph Ȩֱͼһ
+void Graph::record_loaded_weights() {
+    double min_weight = 0.0, max_weight = 0.0;
+    bool any = false;
+    for (const auto& vertex : vertices_) {
+        for (const auto& edge : vertex.second.edges) {
+            if (!(edge.first < vertex.first)) continue;
+            if (!any || edge.second < min_weight) min_weight = edge.second;
+            if (!any || edge.second > max_weight) max_weight = edge.second;
+            any = true;
+        }
+    }
+    if (any) stats_.set_weight_range(min_weight, max_weight);
+    for (const auto& vertex : vertices_) {
+        for (const auto& edge : vertex.second.edges) {
+            if (edge.first < vertex.first) stats_.on_edge_loaded(edge.second);
         }
     }
-    return tokens;
+}
+
+// ˫ɾһߣɾǰ˵ǰͳ
+void Graph::cut_edge(Vertex& node, const Key& nodeId, const Key& target, GraphStats::Tier tier) {
+    Vertex& other = vertices_[target];
+    const auto edge = node.edges.find(target);
+    stats_.on_edge_cut(node.edges.size(), other.edges.size(), edge->second, tier);
+    other.edges.erase(nodeId);
+    node.edges.erase(edge);
 }
 
 // ȡڽӽڵʵ
-const unordered_map<string, double>& Graph::neighbors(const string& id) const {
-    return vertices_.at(id).edges;
+unordered_map<string, double> Graph::neighbors(const string& id) const {
+    const auto& edges = neighbor_edges(id);
+    unordered_map<string, double> result;
+    result.reserve(edges.size());
+    for (const auto& edge : edges) result.emplace(string(edge.first), edge.second);
+    return result;
+}
+
+const pmr::unordered_map<pmr::string, double>& Graph::neighbor_edges(const string& id) const {
+    return vertices_.at(Key(id)).edges;
 }
 
 // Գ֤ʵ
 void Graph::validate_symmetry() const {
+    LSPQ_PROFILE_SCOPE("Graph::validate_symmetry");
     for (size_t i = 0; i < nodeIds_.size(); ++i) {
-        const string& id1 = nodeIds_[i];
+        const Key& id1 = nodeIds_[i];
         const auto& edges1 = vertices_.at(id1).edges;
         for (size_t j = 0; j < nodeIds_.size(); ++j) {
             if (i == j) continue;
-            const string& id2 = nodeIds_[j];
+            const Key& id2 = nodeIds_[j];
             const auto& edges2 = vertices_.at(id2).edges;
 
             if (edges1.find(id2) == edges1.end()) {
-                throw runtime_error("ͼԳƻ: " + id1 + " -> " + id2 + " δ洢");
+                throw runtime_error("ͼԳƻ: " + string(id1) + " -> " + string(id2) + " δ洢");
             }
             if (abs(edges1.at(id2) - edges2.at(id1)) > 1e-9) {
-                throw runtime_error("Ȩزһ: " + id1 + " -> " + id2 + " = " +
+                throw runtime_error("Ȩزһ: " + string(id1) + " -> " + string(id2) + " = " +
                     to_string(edges1.at(id2)) + " vs " +
                     to_string(edges2.at(id1)));
             }
@@ -169,16 +246,19 @@ void Graph::print_summary() const {
 
 void Graph::perform_neighborhood_analysis(double small_threshold, double medium_threshold,
     double large_threshold, size_t min_neighbors) {
+    LSPQ_PROFILE_SCOPE("Graph::perform_neighborhood_analysis");
     cout << "ʼ...\n";
     cout << "ֵ: =" << small_threshold << ", =" << medium_threshold
         << ", С=" << large_threshold << "\n";
     cout << "ھԼ: =" << min_neighbors << "\n";
+    stats_.begin_pruning();
 
     int nodes_processed = 0;
     int small_threshold_cuts = 0;
     int medium_threshold_cuts = 0;
     int large_threshold_cuts = 0;
     int skipped_nodes = 0;
+    size_t edges_cut = 0;
 
     for (const auto& nodeId : nodeIds_) {
         auto& node = vertices_[nodeId];
@@ -186,11 +266,12 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
         // ھڵޣ
         if (node.edges.size() <= min_neighbors) {
             skipped_nodes++;
+            stats_.on_node_skipped();
             continue;
         }
 
         // ߰Ȩ򣨴ӴС
-        vector<pair<string, double>> sorted_edges;
+        vector<pair<Key, double>> sorted_edges;
         for (const auto& edge : node.edges) {
             sorted_edges.push_back(edge);
         }
@@ -198,7 +279,7 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
             [](const auto& a, const auto& b) { return a.second > b.second; });
 
         // Ҫɾı
-        vector<string> edges_to_remove;
+        vector<Key> edges_to_remove;
 
         // Сֵи
         for (const auto& edge : sorted_edges) {
@@ -212,10 +293,11 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
             // СֵиУִɾ
             for (const auto& target : edges_to_remove) {
                 // ˫ɾԱͼĶԳ
-                vertices_[target].edges.erase(nodeId);
-                node.edges.erase(target);
+                cut_edge(node, nodeId, target, GraphStats::kSmallTier);
             }
+            edges_cut += edges_to_remove.size();
             small_threshold_cuts++;
+            stats_.on_node_tier(GraphStats::kSmallTier);
             nodes_processed++;
             continue;
         }
@@ -231,10 +313,11 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
         if (node.edges.size() - edges_to_remove.size() >= min_neighbors) {
             // ֵиУִɾ
             for (const auto& target : edges_to_remove) {
-                vertices_[target].edges.erase(nodeId);
-                node.edges.erase(target);
+                cut_edge(node, nodeId, target, GraphStats::kMediumTier);
             }
+            edges_cut += edges_to_remove.size();
             medium_threshold_cuts++;
+            stats_.on_node_tier(GraphStats::kMediumTier);
             nodes_processed++;
             continue;
         }
@@ -249,12 +332,14 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
 
         // ۽Σִдֵи
         for (const auto& target : edges_to_remove) {
-            vertices_[target].edges.erase(nodeId);
-            node.edges.erase(target);
+            cut_edge(node, nodeId, target, GraphStats::kLargeTier);
         }
+        edges_cut += edges_to_remove.size();
         large_threshold_cuts++;
+        stats_.on_node_tier(GraphStats::kLargeTier);
         nodes_processed++;
     }
+    LSPQ_PROFILE_COUNT("edges_cut", edges_cut);
 
     cout << ":\n";
     cout << "ڵ: " << nodes_processed << "\n";
@@ -271,10 +356,10 @@ void Graph::perform_neighborhood_analysis(double small_threshold, double medium_
 int Graph::count_connected_components() const {
     // The previous implementation used a separate DFS.
     // Now, it leverages the get_connected_components method for consistency and efficiency.
-    return get_connected_components().size();
+    return component_keys().size();
 }
 
-void Graph::find_component_nodes_dfs(const string& current_node, unordered_map<string, bool>& visited, vector<string>& component_nodes) const {
+void Graph::find_component_nodes_dfs(const Key& current_node, unordered_map<Key, bool>& visited, vector<Key>& component_nodes) const {
     visited[current_node] = true;
     component_nodes.push_back(current_node);
 
@@ -282,7 +367,7 @@ void Graph::find_component_nodes_dfs(const string& current_node, unordered_map<s
     // It's possible for a node to have no edges after pruning.
     if (vertices_.count(current_node)) {
         for (const auto& edge_pair : vertices_.at(current_node).edges) {
-            const string& neighbor_node = edge_pair.first;
+            const Key& neighbor_node = edge_pair.first;
             // Ensure neighbor_node is a valid node ID that should be in visited map
             // and has not been visited yet.
             if (visited.count(neighbor_node) && !visited.at(neighbor_node)) {
@@ -292,20 +377,21 @@ void Graph::find_component_nodes_dfs(const string& current_node, unordered_map<s
     }
 }
 
-// ʵ֣ȡӵ
-vector<vector<string>> Graph::get_connected_components() const {
-    vector<vector<string>> all_components;
-    unordered_map<string, bool> visited;
+// ڲͱʾֱ֧ͨʹظתַ
+vector<vector<Graph::Key>> Graph::component_keys() const {
+    LSPQ_PROFILE_SCOPE("Graph::connected_components");
+    vector<vector<Key>> all_components;
+    unordered_map<Key, bool> visited;
 
     // Initialize visited map for all known node IDs
-    for (const string& node_id : nodeIds_) {
+    for (const Key& node_id : nodeIds_) {
         visited[node_id] = false;
     }
 
-    for (const string& node_id : nodeIds_) {
+    for (const Key& node_id : nodeIds_) {
         // If node_id exists in visited map and has not been visited yet
         if (visited.count(node_id) && !visited.at(node_id)) {
-            vector<string> current_component_nodes;
+            vector<Key> current_component_nodes;
             find_component_nodes_dfs(node_id, visited, current_component_nodes);
             // A component is formed even if it's an isolated node.
             // current_component_nodes will contain at least node_id.
@@ -315,30 +401,42 @@ vector<vector<string>> Graph::get_connected_components() const {
     return all_components;
 }
 
-// ӡھͳϢ
-void Graph::print_neighborhood_stats() const {
-    size_t min_neighbors = SIZE_MAX;
-    size_t max_neighbors = 0;
-    double avg_neighbors = 0.0;
-
-    for (const auto& nodeId : nodeIds_) {
-        size_t neighbor_count = vertices_.at(nodeId).edges.size();
-        min_neighbors = min(min_neighbors, neighbor_count);
-        max_neighbors = max(max_neighbors, neighbor_count);
-        avg_neighbors += neighbor_count;
+// ʵ֣ȡӵ
+vector<vector<string>> Graph::get_connected_components() const {
+    vector<vector<string>> all_components;
+    for (const auto& component : component_keys()) {
+        vector<string> names;
+        names.reserve(component.size());
+        for (const Key& node_id : component) names.emplace_back(node_id);
+        all_components.push_back(move(names));
     }
+    return all_components;
+}
 
-    avg_neighbors /= nodeIds_.size();
-
+// ӡھͳϢֱӶȡֱͼڵ
+void Graph::print_neighborhood_stats() const {
     cout << "ھͳϢ:\n";
-    cout << "Сھ: " << min_neighbors << "\n";
-    cout << "ھ: " << max_neighbors << "\n";
-    cout << "ƽھ: " << avg_neighbors << "\n";
+    cout << "Сھ: " << stats_.min_degree() << "\n";
+    cout << "ھ: " << stats_.max_degree() << "\n";
+    cout << "ƽھ: " << stats_.mean_degree() << "\n";
+}
+
+void Graph::export_statistics_tsv(const string& output_path) const {
+    vector<size_t> sizes;
+    for (const auto& component : component_keys()) sizes.push_back(component.size());
+    stats_.export_tsv(output_path, sizes);
+}
+
+void Graph::export_statistics_json(const string& output_path) const {
+    vector<size_t> sizes;
+    for (const auto& component : component_keys()) sizes.push_back(component.size());
+    stats_.export_json(output_path, sizes);
 }
 
 // ʵ֣ڽӾļ
 void Graph::export_adjacency_matrix(const string& output_path) const {
-    ofstream outfile(output_path);
+    LSPQ_PROFILE_SCOPE("Graph::export_adjacency_matrix");
+    AsyncFileWriter outfile(output_path);
     if (!outfile.is_open()) {
         throw runtime_error("޷ļ: " + output_path);
     }
@@ -351,10 +449,10 @@ void Graph::export_adjacency_matrix(const string& output_path) const {
     outfile << "\n";
 
     // ӡÿһ
-    for (const string& row_node_id : nodeIds_) {
+    for (const Key& row_node_id : nodeIds_) {
         outfile << row_node_id << "\t"; // б (ڵ)
         for (size_t i = 0; i < nodeIds_.size(); ++i) {
-            const string& col_node_id = nodeIds_[i];
+            const Key& col_node_id = nodeIds_[i];
             if (row_node_id == col_node_id) {
                 outfile << "-";
             }
@@ -397,7 +495,7 @@ void Graph::export_adjacency_matrix(const string& output_path) const {
 //        }
 //        file_path_str += "component_" + to_string(i + 1) + ".txt";
 //
-//        ofstream outfile(file_path_str);
+//        AsyncFileWriter outfile(file_path_str);
 //        if (!outfile.is_open()) {
 //            cerr << ": ޷ļ " << file_path_str << " д롣" << endl;
 //            continue; // Skip this component if file cannot be opened
@@ -417,9 +515,10 @@ void Graph::export_adjacency_matrix(const string& output_path) const {
 //}
 
 void Graph::export_all_components_to_single_file(const string& output_file_path) const {
-    vector<vector<string>> components = get_connected_components();
+    LSPQ_PROFILE_SCOPE("Graph::export_all_components_to_single_file");
+    vector<vector<Key>> components = component_keys();
 
-    ofstream outfile(output_file_path);
+    AsyncFileWriter outfile(output_file_path);
     if (!outfile.is_open()) {
         throw runtime_error("޷ļ: " + output_file_path);
     }
@@ -435,7 +534,7 @@ void Graph::export_all_components_to_single_file(const string& output_file_path)
         }
 
         outfile << "Component " << (i + 1) << " (Nodes: " << component_nodes.size() << "):\n";
-        for (const string& node_id : component_nodes) {
+        for (const Key& node_id : component_nodes) {
             outfile << node_id << "\n";
         }
         outfile << "\n"; // Add a blank line between components for better readability
@@ -447,7 +546,8 @@ void Graph::export_all_components_to_single_file(const string& output_file_path)
 
 // ޸ĺĺʵ֣Ϊ Cytoscape ѺõıбʽȨ
 void Graph::export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const {
-    ofstream outfile(output_path);
+    LSPQ_PROFILE_SCOPE("Graph::export_edge_list_for_cytoscape");
+    AsyncFileWriter outfile(output_path);
     if (!outfile.is_open()) {
         throw runtime_error("޷ļ: " + output_path);
     }
@@ -456,11 +556,11 @@ void Graph::export_edge_list_for_cytoscape(const string& output_path, const stri
     outfile << "SourceNode\tTargetNode\tInteractionType\tWeight\n";
 
     for (const auto& node_entry : vertices_) {
-        const string& source_node = node_entry.first;
+        const Key& source_node = node_entry.first;
         const Vertex& vertex_data = node_entry.second;
 
         for (const auto& edge_entry : vertex_data.edges) {
-            const string& target_node = edge_entry.first;
+            const Key& target_node = edge_entry.first;
             double weight = edge_entry.second; // ȡߵȨ
 
             // ȷͼеÿֻһ
@@ -478,14 +578,15 @@ void Graph::export_edge_list_for_cytoscape(const string& output_path, const stri
 }
 
 void Graph::export_all_component_adjacency_matrices_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("Graph::export_all_component_adjacency_matrices_to_single_file");
     // Open the output file
-    ofstream outfile(output_file_path);
+    AsyncFileWriter outfile(output_file_path);
     if (!outfile.is_open()) {
         throw runtime_error("޷ļ: " + output_file_path);
     }
 
     // Get all connected components
-    vector<vector<string>> components = get_connected_components();
+    vector<vector<Key>> components = component_keys();
     cout << " " << components.size() << " ֧ͨڵڽӾ: " << output_file_path << endl;
 
     for (size_t i = 0; i < components.size(); ++i) {
@@ -507,10 +608,10 @@ void Graph::export_all_component_adjacency_matrices_to_single_file(const string&
         outfile << "\n";
 
         // Write each row of the adjacency matrix
-        for (const string& row_node_id : component_nodes) {
+        for (const Key& row_node_id : component_nodes) {
             outfile << row_node_id << "\t"; // Row header (node ID)
             for (size_t j = 0; j < component_nodes.size(); ++j) {
-                const string& col_node_id = component_nodes[j];
+                const Key& col_node_id = component_nodes[j];
                 if (row_node_id == col_node_id) {
                     outfile << "-"; // Diagonal
                 }
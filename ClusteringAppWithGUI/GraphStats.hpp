@@ -0,0 +1,305 @@
+/**
+ ********************************************
+ * @file    :GraphStats.hpp
+ * @author  :XXY
+ * @brief   :Incremental degree / weight / component statistics
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_GRAPH_STATS_HPP
+#define LSPQ_GRAPH_STATS_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// ͼͳϢ
+// ֲԡ -> ڵֱͼ棬غͼʱ O(1) £
+// Ȩֱͼڼʱ¼ȫߣʱֵ¼ = ȫ - Ѽ
+// С//ƽٷλֱͼõڵ
+class GraphStats {
+public:
+    enum Tier { kSmallTier = 0, kMediumTier, kLargeTier, kTierCount };
+
+private:
+    // ֱͼ
+    vector<size_t> degree_count_;
+    vector<size_t> degree_count_before_; // ֦ʼʱĿ
+    size_t nodes_ = 0;
+    size_t degree_sum_ = 0;
+
+    // Ȩֱͼ[min_weight_, max_weight_] ȿ䣬Խֵ
+    double min_weight_;
+    double bin_width_;
+    vector<size_t> loaded_weights_;
+    vector<size_t> cut_weights_[kTierCount];
+
+    // Ľڵı
+    size_t tier_nodes_[kTierCount] = {};
+    size_t tier_cuts_[kTierCount] = {};
+    size_t skipped_nodes_ = 0;
+    bool pruned_ = false;
+
+    size_t bin_of(double weight) const;
+    static size_t percentile_of(const vector<size_t>& histogram, size_t total, double p);
+    static void write_histogram_json(ostream& out, const vector<size_t>& histogram);
+
+public:
+    explicit GraphStats(double min_weight = 0.0, double max_weight = 100.0, double bin_width = 1.0);
+
+    // ʵȨطΧ·䣨Լ 100 䣬ȡ 1/2/510^kȨֱͼ
+    // ٷֱȾõĬͬ [0,100]  1 䣬0~1 Сõ 0.01 ķ䡣
+    void set_weight_range(double min_weight, double max_weight);
+
+    // ؽ׶Σнڵʼܾͬ󣩣ÿڵԵһ on_edge_loaded
+    void reset_degrees(size_t nodes, size_t degree);
+    void on_edge_loaded(double weight) { ++loaded_weights_[bin_of(weight)]; }
+
+    // ֦׶
+    void begin_pruning();
+    void on_node_tier(Tier tier) { ++tier_nodes_[tier]; }
+    void on_node_skipped() { ++skipped_nodes_; }
+    void on_edge_cut(size_t source_degree, size_t target_degree, double weight, Tier tier);
+
+    // ѯ
+    size_t node_count() const { return nodes_; }
+    size_t min_degree() const;
+    size_t max_degree() const;
+    double mean_degree() const { return nodes_ ? static_cast<double>(degree_sum_) / nodes_ : 0.0; }
+    size_t degree_percentile(double p) const { return percentile_of(degree_count_, nodes_, p); }
+    const vector<size_t>& degree_histogram() const { return degree_count_; }
+    const vector<size_t>& degree_histogram_before() const { return degree_count_before_; }
+    vector<size_t> surviving_weight_histogram() const;
+
+    // component_sizes Ϊ֧ͨĽڵ
+    void export_tsv(const string& output_path, const vector<size_t>& component_sizes) const;
+    void export_json(const string& output_path, const vector<size_t>& component_sizes) const;
+};
+
+/**************** Աʵ ****************/
+
+GraphStats::GraphStats(double min_weight, double max_weight, double bin_width)
+    : min_weight_(min_weight), bin_width_(bin_width) {
+    if (!(bin_width > 0) || !(max_weight > min_weight)) {
+        throw invalid_argument("ͳƷЧ");
+    }
+    const size_t bins = static_cast<size_t>(ceil((max_weight - min_weight) / bin_width)) + 1;
+    loaded_weights_.assign(bins, 0);
+    for (auto& h : cut_weights_) h.assign(bins, 0);
+}
+
+void GraphStats::set_weight_range(double min_weight, double max_weight) {
+    double width = 1.0;
+    if (max_weight > min_weight) {
+        const double raw = (max_weight - min_weight) / 100.0;
+        const double scale = pow(10.0, floor(log10(raw)));
+        const double fraction = raw / scale;
+        width = (fraction <= 1.0 ? 1.0 : fraction <= 2.0 ? 2.0 : fraction <= 5.0 ? 5.0 : 10.0) * scale;
+    }
+    bin_width_ = width;
+    min_weight_ = floor(min_weight / width) * width;
+    const size_t bins = static_cast<size_t>(floor((max_weight - min_weight_) / width + 1e-9)) + 1;
+    loaded_weights_.assign(bins, 0);
+    for (auto& h : cut_weights_) h.assign(bins, 0);
+}
+
+size_t GraphStats::bin_of(double weight) const {
+    if (!(weight > min_weight_)) return 0;
+    const size_t bin = static_cast<size_t>((weight - min_weight_) / bin_width_);
+    return min(bin, loaded_weights_.size() - 1);
+}
+
+void GraphStats::reset_degrees(size_t nodes, size_t degree) {
+    nodes_ = nodes;
+    degree_count_.assign(degree + 1, 0);
+    degree_count_[degree] = nodes;
+    degree_sum_ = nodes * degree;
+    degree_count_before_.clear();
+    fill(loaded_weights_.begin(), loaded_weights_.end(), 0);
+    for (auto& h : cut_weights_) fill(h.begin(), h.end(), 0);
+    fill(begin(tier_nodes_), end(tier_nodes_), 0);
+    fill(begin(tier_cuts_), end(tier_cuts_), 0);
+    skipped_nodes_ = 0;
+    pruned_ = false;
+}
+
+void GraphStats::begin_pruning() {
+    degree_count_before_ = degree_count_;
+    pruned_ = true;
+}
+
+// һߣ˵ԭͰƵһͰ
+void GraphStats::on_edge_cut(size_t source_degree, size_t target_degree, double weight, Tier tier) {
+    --degree_count_[source_degree];
+    ++degree_count_[source_degree - 1];
+    --degree_count_[target_degree];
+    ++degree_count_[target_degree - 1];
+    degree_sum_ -= 2;
+    ++cut_weights_[tier][bin_of(weight)];
+    ++tier_cuts_[tier];
+}
+
+size_t GraphStats::min_degree() const {
+    for (size_t d = 0; d < degree_count_.size(); ++d) {
+        if (degree_count_[d]) return d;
+    }
+    return 0;
+}
+
+size_t GraphStats::max_degree() const {
+    for (size_t d = degree_count_.size(); d-- > 0;) {
+        if (degree_count_[d]) return d;
+    }
+    return 0;
+}
+
+// Ȱٷλ ceil(p/100 * total) ֵ
+size_t GraphStats::percentile_of(const vector<size_t>& histogram, size_t total, double p) {
+    if (total == 0) return 0;
+    const size_t rank = max<size_t>(1, static_cast<size_t>(ceil(p / 100.0 * total)));
+    size_t seen = 0;
+    for (size_t d = 0; d < histogram.size(); ++d) {
+        seen += histogram[d];
+        if (seen >= rank) return d;
+    }
+    return histogram.empty() ? 0 : histogram.size() - 1;
+}
+
+vector<size_t> GraphStats::surviving_weight_histogram() const {
+    vector<size_t> surviving = loaded_weights_;
+    for (const auto& h : cut_weights_) {
+        for (size_t b = 0; b < surviving.size(); ++b) surviving[b] -= h[b];
+    }
+    return surviving;
+}
+
+// TSV á//ֵгֱͼֻ
+void GraphStats::export_tsv(const string& output_path, const vector<size_t>& component_sizes) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    static const char* tier_names[kTierCount] = { "small", "medium", "large" };
+    static const double percentiles[] = { 50, 90, 99 };
+
+    outfile << "Section\tKey\tValue\n";
+    outfile << "summary\tnodes\t" << nodes_ << "\n";
+    outfile << "summary\tedges\t" << degree_sum_ / 2 << "\n";
+    outfile << "summary\tmin_degree\t" << min_degree() << "\n";
+    outfile << "summary\tmax_degree\t" << max_degree() << "\n";
+    outfile << "summary\tmean_degree\t" << mean_degree() << "\n";
+    for (double p : percentiles) {
+        outfile << "summary\tp" << p << "_degree\t" << degree_percentile(p) << "\n";
+    }
+    outfile << "summary\tcomponents\t" << component_sizes.size() << "\n";
+    outfile << "summary\tskipped_nodes\t" << skipped_nodes_ << "\n";
+    for (int t = 0; t < kTierCount; ++t) {
+        outfile << "summary\t" << tier_names[t] << "_tier_nodes\t" << tier_nodes_[t] << "\n";
+        outfile << "summary\t" << tier_names[t] << "_tier_cut_edges\t" << tier_cuts_[t] << "\n";
+    }
+
+    auto write_histogram = [&](const string& section, const vector<size_t>& histogram, bool weight_bins) {
+        for (size_t b = 0; b < histogram.size(); ++b) {
+            if (!histogram[b]) continue;
+            outfile << section << "\t";
+            if (weight_bins) outfile << min_weight_ + b * bin_width_;
+            else outfile << b;
+            outfile << "\t" << histogram[b] << "\n";
+        }
+    };
+
+    if (pruned_) write_histogram("degree_before", degree_count_before_, false);
+    write_histogram("degree", degree_count_, false);
+    write_histogram("weight_loaded", loaded_weights_, true);
+    for (int t = 0; t < kTierCount; ++t) {
+        write_histogram(string("weight_cut_") + tier_names[t], cut_weights_[t], true);
+    }
+    write_histogram("weight_surviving", surviving_weight_histogram(), true);
+
+    map<size_t, size_t> size_distribution;
+    for (size_t s : component_sizes) ++size_distribution[s];
+    for (const auto& entry : size_distribution) {
+        outfile << "component_size\t" << entry.first << "\t" << entry.second << "\n";
+    }
+
+    outfile.close();
+    cout << "ͳϢѵ: " << output_path << endl;
+}
+
+void GraphStats::write_histogram_json(ostream& out, const vector<size_t>& histogram) {
+    out << "[";
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        out << (b ? "," : "") << histogram[b];
+    }
+    out << "]";
+}
+
+// JSON еֱͼΪ飬±꼴
+void GraphStats::export_json(const string& output_path, const vector<size_t>& component_sizes) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    static const char* tier_names[kTierCount] = { "small", "medium", "large" };
+
+    outfile << "{\n";
+    outfile << "  \"nodes\": " << nodes_ << ",\n";
+    outfile << "  \"edges\": " << degree_sum_ / 2 << ",\n";
+    outfile << "  \"degree\": {\"min\": " << min_degree() << ", \"max\": " << max_degree()
+        << ", \"mean\": " << mean_degree() << ", \"p50\": " << degree_percentile(50)
+        << ", \"p90\": " << degree_percentile(90) << ", \"p99\": " << degree_percentile(99) << "},\n";
+    outfile << "  \"degree_histogram\": ";
+    write_histogram_json(outfile, degree_count_);
+    outfile << ",\n";
+    if (pruned_) {
+        outfile << "  \"degree_histogram_before\": ";
+        write_histogram_json(outfile, degree_count_before_);
+        outfile << ",\n";
+    }
+
+    outfile << "  \"tiers\": {";
+    for (int t = 0; t < kTierCount; ++t) {
+        outfile << (t ? ", " : "") << "\"" << tier_names[t] << "\": {\"nodes\": " << tier_nodes_[t]
+            << ", \"cut_edges\": " << tier_cuts_[t] << "}";
+    }
+    outfile << "},\n";
+    outfile << "  \"skipped_nodes\": " << skipped_nodes_ << ",\n";
+
+    outfile << "  \"weight_bins\": {\"min\": " << min_weight_ << ", \"width\": " << bin_width_
+        << ", \"count\": " << loaded_weights_.size() << "},\n";
+    outfile << "  \"weight_histograms\": {\n    \"loaded\": ";
+    write_histogram_json(outfile, loaded_weights_);
+    for (int t = 0; t < kTierCount; ++t) {
+        outfile << ",\n    \"cut_" << tier_names[t] << "\": ";
+        write_histogram_json(outfile, cut_weights_[t]);
+    }
+    outfile << ",\n    \"surviving\": ";
+    write_histogram_json(outfile, surviving_weight_histogram());
+    outfile << "\n  },\n";
+
+    map<size_t, size_t> size_distribution;
+    for (size_t s : component_sizes) ++size_distribution[s];
+    outfile << "  \"components\": " << component_sizes.size() << ",\n";
+    outfile << "  \"component_size_distribution\": {";
+    bool first = true;
+    for (const auto& entry : size_distribution) {
+        outfile << (first ? "" : ", ") << "\"" << entry.first << "\": " << entry.second;
+        first = false;
+    }
+    outfile << "}\n}\n";
+
+    outfile.close();
+    cout << "ͳϢѵ: " << output_path << endl;
+}
+
+#endif // LSPQ_GRAPH_STATS_HPP
@@ -0,0 +1,597 @@
+/**
+ ********************************************
+ * @file    :IncrementalGraph.hpp
+ * @author  :XXY
+ * @brief   :Snapshot-based incremental neighborhood analysis for appended rows
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_INCREMENTAL_GRAPH_HPP
+#define LSPQ_INCREMENTAL_GRAPH_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+// һ֧ͨһνı仯
+struct ComponentChange {
+    size_t component = 0;            // ±ţ 1 ʼ
+    size_t nodes = 0;
+    size_t added_nodes = 0;          // Ľڵ
+    string status;                   // unchanged / grown / merged / split / new
+    vector<size_t> previous;         // ľ֧ͨţ 1 ʼ
+};
+
+struct ComponentDiff {
+    size_t previous_components = 0;
+    size_t unchanged = 0, grown = 0, merged = 0, split = 0, created = 0;
+    vector<ComponentChange> changes;  // ÿ֧ͨһ
+};
+
+// ģʽһηĿգֻ֮ȡеУжȫеƶȣ
+// ڽӹϵжֵ𲢸֧ͨͷ Graph ͬ
+//
+// ǳܵģڵ֮䶼бߡֵıֻҪһδĶ˵
+// һ˿ֻ治ֵıߣߡȨأڵԾΪȨߡ
+//  i ڵ㴦ʱ j > i ı߶ڣ j < i ıߵҽ w >= t_j ʱڣ
+//  j < i ĵȨߵҽ j ʱڡÿڵĴֵµļ
+// ֻı߼ɵõжΪ O(N + )ضɾ
+// ½ڵ׷ڴ˳ĩβɽڵжֻı߶ı䡣
+//
+// ֧ͨûκξɽڵֵߣɵĴȫȻֻھɷ֧Ĳ鼯
+// ϲ³ֵĴߣɷ֧֣ܲȫؽ鼯
+class IncrementalGraph {
+    static constexpr char kMagic[8] = { 'L', 'S', 'P', 'Q', 'I', 'N', 'C', '1' };
+
+    double small_threshold_ = 0.0;
+    double medium_threshold_ = 0.0;
+    double large_threshold_ = 0.0;
+    size_t min_neighbors_ = 0;
+
+    vector<string> nodeIds_;
+    vector<size_t> offsets_;     // ߣѹĿÿһ
+    vector<uint32_t> targets_;
+    vector<double> weights_;
+
+    vector<double> thresholds_;  // ĽڵΪ
+    vector<uint32_t> component_; // ڵ -> ֧ͨţ֧С±
+    size_t component_count_ = 0;
+
+    IncrementalGraph() = default;
+
+    double floor_threshold() const { return min(small_threshold_, min(medium_threshold_, large_threshold_)); }
+    // ˳жȫڵֵֵ仯ľɽڵold_count ֮ǰĽڵ㣩
+    size_t analyze(size_t old_count, bool& raised);
+    static uint32_t find_root(vector<uint32_t>& parent, uint32_t x);
+    void build_components(vector<uint32_t>& parent);
+    bool survives(uint32_t a, uint32_t b, double w) const {
+        return w >= thresholds_[a] && w >= thresholds_[b];
+    }
+    void union_surviving_edges(vector<uint32_t>& parent, uint32_t node) const;
+    void union_skipped_nodes(vector<uint32_t>& parent) const;
+    // ڵڽӱ CSR
+    void assign_edges(vector<vector<pair<uint32_t, double>>>& adjacency);
+
+public:
+    // ȡ״η
+    IncrementalGraph(const string& dataPath, double small_threshold, double medium_threshold,
+        double large_threshold, size_t min_neighbors);
+
+    static IncrementalGraph load_snapshot(const string& snapshot_path);
+    void save_snapshot(const string& snapshot_path) const;
+
+    // ȡв½ļʽֻͬеУ
+    // ΪȫڵIDɽڵǰ˳򲻱䣬½ڵں󣩣ÿ½ڵһС
+    ComponentDiff append_rows(const string& rows_path);
+
+    size_t node_count() const { return nodeIds_.size(); }
+    size_t kept_edge_count() const { return targets_.size() / 2; }
+    int count_connected_components() const { return static_cast<int>(component_count_); }
+    vector<vector<string>> get_connected_components() const;
+    void export_all_components_to_single_file(const string& output_file_path) const;
+
+    static void print_component_diff(const ComponentDiff& diff);
+    // ֻд仯֧ͨ
+    static void export_component_diff(const ComponentDiff& diff, const string& output_path);
+};
+
+/**************** Աʵ ****************/
+
+constexpr char IncrementalGraph::kMagic[8];
+
+IncrementalGraph::IncrementalGraph(const string& dataPath, double small_threshold, double medium_threshold,
+    double large_threshold, size_t min_neighbors)
+    : small_threshold_(small_threshold), medium_threshold_(medium_threshold),
+    large_threshold_(large_threshold), min_neighbors_(min_neighbors) {
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::load");
+    MatrixInputStream file(dataPath);
+    if (!file) throw runtime_error("޷ļ: " + dataPath);
+
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) {
+        throw runtime_error("ļΪ");
+    }
+    for (string_view id : reader.tokens()) nodeIds_.emplace_back(id);
+    if (nodeIds_.empty()) {
+        throw runtime_error("ڵIDбΪ");
+    }
+
+    //  CsrGraph::symmetrize һ£ڵ (i, j) ȡϺһеֵжȡ
+    const double floor = floor_threshold();
+    vector<vector<pair<uint32_t, double>>> adjacency(nodeIds_.size());
+    for (uint32_t i = 0; i < nodeIds_.size(); ++i) {
+        if (!reader.next_row()) {
+            throw runtime_error("ȱٵ" + to_string(i + 1) + "");
+        }
+        if (reader.size() != nodeIds_.size() + 1) {
+            throw runtime_error("" + to_string(i + 1) + "ƥ䣬Ԥ: " +
+                to_string(nodeIds_.size() + 1) + " ʵ: " + to_string(reader.size()));
+        }
+        if (reader[0] != string_view(nodeIds_[i])) {
+            throw runtime_error("ڵIDƥ:  " + to_string(i + 1) +
+                " Ԥ " + nodeIds_[i] + " ʵ " + string(reader[0]));
+        }
+        for (uint32_t j = 0; j < i; ++j) {
+            double weight;
+            if (!MatrixRowReader::to_double(reader[j + 1], weight)) {
+                throw runtime_error("" + to_string(i + 1) + "е" +
+                    to_string(j + 2) + "ֵЧ: " + string(reader[j + 1]));
+            }
+            if (weight < floor) continue;
+            adjacency[i].emplace_back(j, weight);
+            adjacency[j].emplace_back(i, weight);
+        }
+    }
+    assign_edges(adjacency);
+
+    bool raised = false;
+    analyze(0, raised);
+    vector<uint32_t> parent(nodeIds_.size());
+    for (uint32_t i = 0; i < parent.size(); ++i) parent[i] = i;
+    for (uint32_t i = 0; i < parent.size(); ++i) union_surviving_edges(parent, i);
+    union_skipped_nodes(parent);
+    build_components(parent);
+
+    cout << "ͼ: ڵ " << nodeIds_.size() << "  " << kept_edge_count()
+        << " ֧ͨ " << component_count_ << " \n";
+}
+
+void IncrementalGraph::assign_edges(vector<vector<pair<uint32_t, double>>>& adjacency) {
+    offsets_.assign(1, 0);
+    targets_.clear();
+    weights_.clear();
+    for (auto& row : adjacency) {
+        sort(row.begin(), row.end());
+        for (const auto& edge : row) {
+            targets_.push_back(edge.first);
+            weights_.push_back(edge.second);
+        }
+        offsets_.push_back(targets_.size());
+        vector<pair<uint32_t, double>>().swap(row);
+    }
+}
+
+size_t IncrementalGraph::analyze(size_t old_count, bool& raised) {
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::analyze");
+    const size_t n = nodeIds_.size();
+    const double skipped = -numeric_limits<double>::infinity();
+    vector<double> previous = move(thresholds_);
+    thresholds_.assign(n, skipped);
+
+    size_t skipped_before = 0;
+    size_t changed = 0;
+    raised = false;
+    for (uint32_t i = 0; i < n; ++i) {
+        size_t kept_after = 0, kept_skipped_before = 0;
+        size_t live = 0, below_small = 0, below_medium = 0, below_large = 0;
+        for (size_t e = offsets_[i]; e < offsets_[i + 1]; ++e) {
+            const uint32_t j = targets_[e];
+            const double w = weights_[e];
+            if (j < i) {
+                if (thresholds_[j] == skipped) ++kept_skipped_before;
+                if (w < thresholds_[j]) continue;
+            }
+            else {
+                ++kept_after;
+            }
+            ++live;
+            below_small += w < small_threshold_;
+            below_medium += w < medium_threshold_;
+            below_large += w < large_threshold_;
+        }
+
+        // ĵȨߣȫȨھӣԼǰȨھ
+        const size_t low = (n - 1 - i - kept_after) + (skipped_before - kept_skipped_before);
+        live += low;
+        below_small += low;
+        below_medium += low;
+        below_large += low;
+
+        double threshold = skipped;
+        if (live <= min_neighbors_) {
+            ++skipped_before;
+        }
+        else if (live - below_small >= min_neighbors_) {
+            threshold = small_threshold_;
+        }
+        else if (live - below_medium >= min_neighbors_) {
+            threshold = medium_threshold_;
+        }
+        else {
+            threshold = large_threshold_;
+        }
+        thresholds_[i] = threshold;
+
+        if (i < old_count && threshold != previous[i]) {
+            ++changed;
+            if (threshold > previous[i]) raised = true;
+        }
+    }
+    return changed;
+}
+
+uint32_t IncrementalGraph::find_root(vector<uint32_t>& parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+void IncrementalGraph::union_surviving_edges(vector<uint32_t>& parent, uint32_t node) const {
+    for (size_t e = offsets_[node]; e < offsets_[node + 1]; ++e) {
+        const uint32_t target = targets_[e];
+        if (!survives(node, target, weights_[e])) continue;
+        const uint32_t a = find_root(parent, node);
+        const uint32_t b = find_root(parent, target);
+        if (a != b) parent[max(a, b)] = min(a, b);
+    }
+}
+
+// ˶ıߴδܣ˱Ľڵ
+void IncrementalGraph::union_skipped_nodes(vector<uint32_t>& parent) const {
+    const double skipped = -numeric_limits<double>::infinity();
+    uint32_t first = UINT32_MAX;
+    for (uint32_t i = 0; i < thresholds_.size(); ++i) {
+        if (thresholds_[i] != skipped) continue;
+        if (first == UINT32_MAX) {
+            first = i;
+            continue;
+        }
+        const uint32_t a = find_root(parent, first);
+        const uint32_t b = find_root(parent, i);
+        if (a != b) parent[max(a, b)] = min(a, b);
+    }
+}
+
+// ϲʱԽС±Ϊ֧еС±꣬±˳żС±
+void IncrementalGraph::build_components(vector<uint32_t>& parent) {
+    const size_t n = nodeIds_.size();
+    component_.assign(n, 0);
+    component_count_ = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t root = find_root(parent, i);
+        component_[i] = root == i ? static_cast<uint32_t>(component_count_++) : component_[root];
+    }
+}
+
+ComponentDiff IncrementalGraph::append_rows(const string& rows_path) {
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::append_rows");
+    MatrixInputStream file(rows_path);
+    if (!file) throw runtime_error("޷ļ: " + rows_path);
+
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) {
+        throw runtime_error("ļΪ");
+    }
+    const size_t old_count = nodeIds_.size();
+    if (reader.size() < old_count) {
+        throw runtime_error("еĽڵIDڿеĽڵ");
+    }
+    for (size_t j = 0; j < old_count; ++j) {
+        if (reader[j] != string_view(nodeIds_[j])) {
+            throw runtime_error("ڵIDƥ:  " + to_string(j + 1) +
+                " Ԥ " + nodeIds_[j] + " ʵ " + string(reader[j]));
+        }
+    }
+    vector<string> ids = nodeIds_;
+    for (size_t j = old_count; j < reader.size(); ++j) ids.emplace_back(reader[j]);
+    const size_t n = ids.size();
+    const size_t added = n - old_count;
+    cout << "ȡ: ½ڵ " << added << " ڵ " << n << "\n";
+
+    // ɵıչΪڽӱ׷½ڵıߣ½ڵ±󣬾Ա
+    const double floor = floor_threshold();
+    vector<vector<pair<uint32_t, double>>> adjacency(n);
+    for (uint32_t i = 0; i < old_count; ++i) {
+        for (size_t e = offsets_[i]; e < offsets_[i + 1]; ++e) adjacency[i].emplace_back(targets_[e], weights_[e]);
+    }
+    vector<double> upper(added * added, 0.0);  // ½ڵ֮ǣڶԳԼ
+    for (uint32_t i = static_cast<uint32_t>(old_count); i < n; ++i) {
+        const size_t row = i - old_count + 1;
+        if (!reader.next_row()) {
+            throw runtime_error("ȱٵ" + to_string(row) + "");
+        }
+        if (reader.size() != n + 1) {
+            throw runtime_error("" + to_string(row) + "ƥ䣬Ԥ: " +
+                to_string(n + 1) + " ʵ: " + to_string(reader.size()));
+        }
+        if (reader[0] != string_view(ids[i])) {
+            throw runtime_error("ڵIDƥ:  " + to_string(row) +
+                " Ԥ " + ids[i] + " ʵ " + string(reader[0]));
+        }
+        for (uint32_t j = 0; j < n; ++j) {
+            if (j == i) continue;
+            double weight;
+            if (!MatrixRowReader::to_double(reader[j + 1], weight)) {
+                throw runtime_error("" + to_string(row) + "е" +
+                    to_string(j + 2) + "ֵЧ: " + string(reader[j + 1]));
+            }
+            if (j > i) {
+                upper[(i - old_count) * added + (j - old_count)] = weight;
+                continue;
+            }
+            if (j >= old_count && abs(weight - upper[(j - old_count) * added + (i - old_count)]) > 1e-9) {
+                throw runtime_error("Ȩزһ: " + ids[i] + " -> " + ids[j]);
+            }
+            if (weight < floor) continue;
+            adjacency[i].emplace_back(j, weight);
+            adjacency[j].emplace_back(i, weight);
+        }
+    }
+    nodeIds_ = move(ids);
+    assign_edges(adjacency);
+
+    // жֵ½ڵһ״̬Ϊδ
+    thresholds_.resize(n, numeric_limits<double>::quiet_NaN());
+    const vector<double> old_thresholds(thresholds_.begin(), thresholds_.begin() + old_count);
+    bool raised = false;
+    const size_t changed = analyze(old_count, raised);
+    cout << "жֵ: " << changed << " ɽڵֵ仯\n";
+
+    const vector<uint32_t> old_component = component_;
+    const size_t old_component_count = component_count_;
+    vector<uint32_t> parent(n);
+    for (uint32_t i = 0; i < n; ++i) parent[i] = i;
+    if (!raised) {
+        // ɵĴȻӾɷֻ֧ϲ½ڵıߺֵ͵ľɽڵı
+        vector<uint32_t> root_of(old_component_count, UINT32_MAX);
+        for (uint32_t i = 0; i < old_count; ++i) {
+            uint32_t& root = root_of[old_component[i]];
+            if (root == UINT32_MAX) root = i;
+            parent[i] = root;
+        }
+        for (uint32_t i = 0; i < old_count; ++i) {
+            if (thresholds_[i] != old_thresholds[i]) union_surviving_edges(parent, i);
+        }
+        for (uint32_t i = static_cast<uint32_t>(old_count); i < n; ++i) union_surviving_edges(parent, i);
+        cout << "֧ͨ: ھɷ֧ϺϲĴ\n";
+    }
+    else {
+        for (uint32_t i = 0; i < n; ++i) union_surviving_edges(parent, i);
+        cout << "֧ͨ: оɽڵֵߣؽ鼯\n";
+    }
+    union_skipped_nodes(parent);
+    build_components(parent);
+
+    // ɷ֧Ա
+    ComponentDiff diff;
+    diff.previous_components = old_component_count;
+    diff.changes.resize(component_count_);
+    for (uint32_t i = 0; i < n; ++i) {
+        ComponentChange& change = diff.changes[component_[i]];
+        change.component = component_[i] + 1;
+        ++change.nodes;
+        if (i >= old_count) {
+            ++change.added_nodes;
+            continue;
+        }
+        const size_t old = old_component[i] + 1;
+        if (find(change.previous.begin(), change.previous.end(), old) == change.previous.end()) {
+            change.previous.push_back(old);
+        }
+    }
+    vector<size_t> pieces(old_component_count, 0);  // ÿɷ֧·֧
+    for (const auto& change : diff.changes) {
+        for (size_t old : change.previous) ++pieces[old - 1];
+    }
+    for (auto& change : diff.changes) {
+        sort(change.previous.begin(), change.previous.end());
+        if (change.previous.empty()) {
+            change.status = "new";
+            ++diff.created;
+        }
+        else if (change.previous.size() > 1) {
+            change.status = "merged";
+            ++diff.merged;
+        }
+        else if (pieces[change.previous[0] - 1] > 1) {
+            change.status = "split";
+            ++diff.split;
+        }
+        else if (change.added_nodes > 0) {
+            change.status = "grown";
+            ++diff.grown;
+        }
+        else {
+            change.status = "unchanged";
+            ++diff.unchanged;
+        }
+    }
+    print_component_diff(diff);
+    return diff;
+}
+
+vector<vector<string>> IncrementalGraph::get_connected_components() const {
+    vector<vector<string>> all_components(component_count_);
+    for (uint32_t i = 0; i < nodeIds_.size(); ++i) all_components[component_[i]].push_back(nodeIds_[i]);
+    return all_components;
+}
+
+void IncrementalGraph::export_all_components_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::export_all_components_to_single_file");
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    const vector<vector<string>> components = get_connected_components();
+    cout << " " << components.size() << " ֧ͨڵļ: " << output_file_path << endl;
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        outfile << "Component " << (i + 1) << " (Nodes: " << components[i].size() << "):\n";
+        for (const string& node_id : components[i]) {
+            outfile << node_id << "\n";
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "֧ͨѵ: " << output_file_path << endl;
+}
+
+void IncrementalGraph::print_component_diff(const ComponentDiff& diff) {
+    cout << "֧ͨ仯: " << diff.previous_components << " -> " << diff.changes.size() << " \n";
+    cout << "δ仯: " << diff.unchanged << ": " << diff.grown << "ϲ: " << diff.merged
+        << ": " << diff.split << ": " << diff.created << "\n";
+}
+
+void IncrementalGraph::export_component_diff(const ComponentDiff& diff, const string& output_path) {
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "component\tnodes\tstatus\tadded_nodes\tprevious_components\n";
+    for (const auto& change : diff.changes) {
+        if (change.status == "unchanged") continue;
+        outfile << change.component << "\t" << change.nodes << "\t" << change.status << "\t"
+            << change.added_nodes << "\t";
+        if (change.previous.empty()) outfile << "-";
+        for (size_t k = 0; k < change.previous.size(); ++k) outfile << (k ? "," : "") << change.previous[k];
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "֧ͨ仯ѵ: " << output_path << endl;
+}
+
+/**************** նд ****************/
+
+namespace incremental_detail {
+
+template <typename T>
+void write_value(ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write_vector(ostream& out, const vector<T>& values) {
+    write_value<uint64_t>(out, values.size());
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+T read_value(istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) throw runtime_error("ļ");
+    return value;
+}
+
+template <typename T>
+vector<T> read_vector(istream& in) {
+    vector<T> values(read_value<uint64_t>(in));
+    if (!in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T))) {
+        throw runtime_error("ļ");
+    }
+    return values;
+}
+
+} // namespace incremental_detail
+
+void IncrementalGraph::save_snapshot(const string& snapshot_path) const {
+    using namespace incremental_detail;
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::save_snapshot");
+    ofstream out(snapshot_path, ios::binary);
+    if (!out.is_open()) {
+        throw runtime_error("޷ļ: " + snapshot_path);
+    }
+
+    out.write(kMagic, sizeof(kMagic));
+    write_value(out, small_threshold_);
+    write_value(out, medium_threshold_);
+    write_value(out, large_threshold_);
+    write_value<uint64_t>(out, min_neighbors_);
+    write_value<uint64_t>(out, nodeIds_.size());
+    for (const string& id : nodeIds_) {
+        write_value<uint32_t>(out, static_cast<uint32_t>(id.size()));
+        out.write(id.data(), id.size());
+    }
+    write_vector(out, offsets_);
+    write_vector(out, targets_);
+    write_vector(out, weights_);
+    write_vector(out, thresholds_);
+    write_vector(out, component_);
+
+    out.close();
+    if (!out) throw runtime_error("дʧ: " + snapshot_path);
+    cout << "ѱ浽: " << snapshot_path << "ڵ " << nodeIds_.size()
+        << "  " << kept_edge_count() << " \n";
+}
+
+IncrementalGraph IncrementalGraph::load_snapshot(const string& snapshot_path) {
+    using namespace incremental_detail;
+    LSPQ_PROFILE_SCOPE("IncrementalGraph::load_snapshot");
+    ifstream in(snapshot_path, ios::binary);
+    if (!in) throw runtime_error("޷ļ: " + snapshot_path);
+
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw runtime_error("ЧĿļ: " + snapshot_path);
+    }
+
+    IncrementalGraph graph;
+    graph.small_threshold_ = read_value<double>(in);
+    graph.medium_threshold_ = read_value<double>(in);
+    graph.large_threshold_ = read_value<double>(in);
+    graph.min_neighbors_ = read_value<uint64_t>(in);
+    graph.nodeIds_.resize(read_value<uint64_t>(in));
+    for (string& id : graph.nodeIds_) {
+        id.resize(read_value<uint32_t>(in));
+        if (!in.read(&id[0], id.size())) throw runtime_error("ļ");
+    }
+    graph.offsets_ = read_vector<size_t>(in);
+    graph.targets_ = read_vector<uint32_t>(in);
+    graph.weights_ = read_vector<double>(in);
+    graph.thresholds_ = read_vector<double>(in);
+    graph.component_ = read_vector<uint32_t>(in);
+
+    const size_t n = graph.nodeIds_.size();
+    if (graph.offsets_.size() != n + 1 || graph.offsets_.back() != graph.targets_.size() ||
+        graph.weights_.size() != graph.targets_.size() || graph.thresholds_.size() != n ||
+        graph.component_.size() != n) {
+        throw runtime_error("ļ");
+    }
+    graph.component_count_ = n ? *max_element(graph.component_.begin(), graph.component_.end()) + 1 : 0;
+
+    cout << "Ѽؿ: ڵ " << n << "  " << graph.kept_edge_count()
+        << " ֧ͨ " << graph.component_count_ << " \n";
+    return graph;
+}
+
+#endif // LSPQ_INCREMENTAL_GRAPH_HPP
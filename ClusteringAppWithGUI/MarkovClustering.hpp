@@ -0,0 +1,376 @@
+/**
+ ********************************************
+ * @file    :MarkovClustering.hpp
+ * @author  :XXY
+ * @brief   :Parallel sparse Markov clustering on the pruned graph
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_MARKOV_CLUSTERING_HPP
+#define LSPQ_MARKOV_CLUSTERING_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+#include "CsrGraph.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+struct MclOptions {
+    double inflation = 2.0;
+    int expansion = 2;               // ÿչΪ expansion 
+    double prune_threshold = 1e-4;   // һСڸֵԪر
+    size_t max_per_column = 1000;    // ÿౣԪ
+    int max_iterations = 100;
+    double chaos_threshold = 1e-4;   // оݣ (ֵ - ƽ) *  ֵ
+    size_t memory_cap_mb = 1024;     // ۼڴޣʱսÿб
+    size_t threads = 0;              // 0 ʾȫӲ߳
+};
+
+// ڼ֦ļȨͼ MCLMarkov ࣩ
+// ѹ洢CSC j Ǵӽڵ j תƸʣԻȨȡеȨ
+// ÿ֣չϡ˷вУÿ߳һۼ ͣԪݲһ
+//  СԪزÿǰ k   ٹһѷԪΪߣ֧ͨΪء
+//  CsrGraph ֧ͨԽ˽Ƕ֧ͨϸ֡
+class MarkovClustering {
+    struct SparseMatrix {
+        vector<size_t> offsets;  // ƫ
+        vector<uint32_t> rows;   // к
+        vector<double> values;
+        size_t nnz() const { return rows.size(); }
+    };
+
+    const CsrGraph& graph_;
+    MclOptions options_;
+    size_t column_limit_ = 0;
+    int iterations_ = 0;
+    double chaos_ = 0.0;
+    vector<vector<uint32_t>> clusters_;
+
+    SparseMatrix build_matrix() const;
+    //  left * rightfinalize Ϊ true ʱÿ֦ chaos
+    SparseMatrix multiply(const SparseMatrix& left, const SparseMatrix& right, bool finalize, double& chaos) const;
+    void finalize_column(vector<uint32_t>& rows, vector<double>& values, double& chaos) const;
+    // ֻǰ column_limit_ Ԫأкű
+    void truncate_column(vector<uint32_t>& rows, vector<double>& values) const;
+    void interpret(const SparseMatrix& matrix);
+
+public:
+    MarkovClustering(const CsrGraph& graph, const MclOptions& options = MclOptions());
+
+    void run();
+    int iterations() const { return iterations_; }
+    const vector<vector<uint32_t>>& clusters() const { return clusters_; }
+    vector<vector<string>> get_clusters() const;
+
+    //  export_all_components_to_single_file ͬĸʽ
+    void export_clusters_to_single_file(const string& output_file_path) const;
+};
+
+/**************** Աʵ ****************/
+
+MarkovClustering::MarkovClustering(const CsrGraph& graph, const MclOptions& options)
+    : graph_(graph), options_(options) {
+    if (!(options.inflation > 1.0)) throw invalid_argument("ϵ 1");
+    if (options.expansion < 2) throw invalid_argument("չݴα벻С 2");
+    if (options.max_per_column == 0) throw invalid_argument("ÿб 0");
+
+    // ÿ̵߳ĳۼֵǡкţȴп۳
+    // ʣಿ󣨵ǰһ֣̯ÿԪ 12 ֽ
+    const size_t n = max<size_t>(graph.node_count(), 1);
+    const size_t workers = resolve_thread_count(options.threads);
+    const size_t accumulator_bytes = workers * n * (sizeof(double) + sizeof(char) + sizeof(uint32_t));
+    const size_t cap_bytes = options.memory_cap_mb * 1024 * 1024;
+    const size_t matrix_bytes = cap_bytes > accumulator_bytes ? cap_bytes - accumulator_bytes : 0;
+    if (matrix_bytes == 0) {
+        cout << "MCL: : " << workers << " ̵߳ۼռ " << accumulator_bytes / (1024 * 1024)
+            << " MBڴ " << options.memory_cap_mb << " MB\n";
+    }
+    const size_t cap_per_column = max<size_t>(matrix_bytes / (2 * n * (sizeof(uint32_t) + sizeof(double))), 1);
+    column_limit_ = min(options.max_per_column, cap_per_column);
+    if (column_limit_ < options.max_per_column) {
+        cout << "MCL: ڴ " << options.memory_cap_mb << " MB ƣÿౣ "
+            << column_limit_ << " Ԫ\n";
+    }
+}
+
+MarkovClustering::SparseMatrix MarkovClustering::build_matrix() const {
+    const size_t n = graph_.node_count();
+    SparseMatrix matrix;
+    matrix.offsets.assign(n + 1, 0);
+
+    vector<pair<uint32_t, double>> column;
+    for (uint32_t j = 0; j < n; ++j) {
+        column.clear();
+        double self_weight = 0.0;
+        graph_.for_each_neighbor(j, [&](uint32_t i, double w) {
+            if (w <= 0.0) return;
+            column.emplace_back(i, w);
+            self_weight = max(self_weight, w);
+        });
+        column.emplace_back(j, self_weight > 0.0 ? self_weight : 1.0);
+        sort(column.begin(), column.end());
+
+        double sum = 0.0;
+        for (const auto& entry : column) sum += entry.second;
+        for (const auto& entry : column) {
+            matrix.rows.push_back(entry.first);
+            matrix.values.push_back(entry.second / sum);
+        }
+        matrix.offsets[j + 1] = matrix.rows.size();
+    }
+    return matrix;
+}
+
+// ͡СԪءضϵǰ k 󲢹һͬʱе chaos
+void MarkovClustering::finalize_column(vector<uint32_t>& rows, vector<double>& values, double& chaos) const {
+    double sum = 0.0;
+    for (double& v : values) {
+        v = pow(v, options_.inflation);
+        sum += v;
+    }
+    for (double& v : values) v /= sum;
+
+    size_t keep = 0;
+    double max_value = 0.0;
+    for (size_t k = 0; k < values.size(); ++k) max_value = max(max_value, values[k]);
+    for (size_t k = 0; k < values.size(); ++k) {
+        // ԪǱ֤вΪ
+        if (values[k] >= options_.prune_threshold || values[k] == max_value) {
+            rows[keep] = rows[k];
+            values[keep] = values[k];
+            ++keep;
+        }
+    }
+    rows.resize(keep);
+    values.resize(keep);
+
+    truncate_column(rows, values);
+
+    sum = 0.0;
+    for (double v : values) sum += v;
+    double square_sum = 0.0;
+    max_value = 0.0;
+    for (double& v : values) {
+        v /= sum;
+        square_sum += v * v;
+        max_value = max(max_value, v);
+    }
+    chaos = (max_value - square_sum) * values.size();
+}
+
+void MarkovClustering::truncate_column(vector<uint32_t>& rows, vector<double>& values) const {
+    const size_t count = rows.size();
+    if (count <= column_limit_) return;
+
+    vector<size_t> order(count);
+    for (size_t k = 0; k < count; ++k) order[k] = k;
+    nth_element(order.begin(), order.begin() + column_limit_, order.end(),
+        [&](size_t a, size_t b) { return values[a] != values[b] ? values[a] > values[b] : rows[a] < rows[b]; });
+    order.resize(column_limit_);
+    sort(order.begin(), order.end());
+    for (size_t k = 0; k < order.size(); ++k) {
+        rows[k] = rows[order[k]];
+        values[k] = values[order[k]];
+    }
+    rows.resize(column_limit_);
+    values.resize(column_limit_);
+}
+
+MarkovClustering::SparseMatrix MarkovClustering::multiply(const SparseMatrix& left, const SparseMatrix& right,
+    bool finalize, double& chaos) const {
+    const size_t n = graph_.node_count();
+    const size_t workers = resolve_thread_count(options_.threads);
+    const size_t block = 256;
+    const size_t blocks = (n + block - 1) / block;
+
+    // ÿԼУ󰴿˳ƴӣ߳޹
+    struct BlockResult {
+        vector<size_t> counts;
+        vector<uint32_t> rows;
+        vector<double> values;
+        double chaos = 0.0;
+    };
+    vector<BlockResult> results(blocks);
+    vector<vector<double>> accumulators(workers, vector<double>(n, 0.0));
+    vector<vector<char>> touched_flags(workers, vector<char>(n, 0));
+    vector<vector<uint32_t>> touched(workers);
+
+    parallel_for_blocks(n, block, workers, [&](size_t begin, size_t end, size_t worker) {
+        BlockResult& result = results[begin / block];
+        vector<double>& accumulator = accumulators[worker];
+        vector<char>& is_touched = touched_flags[worker];
+        vector<uint32_t>& rows = touched[worker];
+        vector<uint32_t> column_rows;
+        vector<double> column_values;
+
+        for (size_t j = begin; j < end; ++j) {
+            //  j  = sum_k right[k, j] * left ĵ k 
+            rows.clear();
+            for (size_t e = right.offsets[j]; e < right.offsets[j + 1]; ++e) {
+                const uint32_t k = right.rows[e];
+                const double factor = right.values[e];
+                for (size_t f = left.offsets[k]; f < left.offsets[k + 1]; ++f) {
+                    const uint32_t i = left.rows[f];
+                    if (!is_touched[i]) {
+                        is_touched[i] = 1;
+                        rows.push_back(i);
+                    }
+                    accumulator[i] += factor * left.values[f];
+                }
+            }
+            sort(rows.begin(), rows.end());
+            column_rows.assign(rows.begin(), rows.end());
+            column_values.resize(rows.size());
+            for (size_t r = 0; r < rows.size(); ++r) {
+                column_values[r] = accumulator[rows[r]];
+                accumulator[rows[r]] = 0.0;
+                is_touched[rows[r]] = 0;
+            }
+
+            if (finalize) {
+                double column_chaos = 0.0;
+                finalize_column(column_rows, column_values, column_chaos);
+                result.chaos = max(result.chaos, column_chaos);
+            } else {
+                // мݴͬÿԼ expansion > 2 ʱδ֦ĳ˻űڴ
+                truncate_column(column_rows, column_values);
+            }
+            result.counts.push_back(column_rows.size());
+            result.rows.insert(result.rows.end(), column_rows.begin(), column_rows.end());
+            result.values.insert(result.values.end(), column_values.begin(), column_values.end());
+        }
+    });
+
+    SparseMatrix product;
+    product.offsets.assign(n + 1, 0);
+    size_t total = 0;
+    for (const auto& result : results) total += result.rows.size();
+    product.rows.reserve(total);
+    product.values.reserve(total);
+
+    chaos = 0.0;
+    size_t column = 0;
+    for (auto& result : results) {
+        for (size_t count : result.counts) {
+            product.offsets[column + 1] = product.offsets[column] + count;
+            ++column;
+        }
+        product.rows.insert(product.rows.end(), result.rows.begin(), result.rows.end());
+        product.values.insert(product.values.end(), result.values.begin(), result.values.end());
+        chaos = max(chaos, result.chaos);
+        result = BlockResult();
+    }
+    return product;
+}
+
+void MarkovClustering::run() {
+    LSPQ_PROFILE_SCOPE("MarkovClustering::run");
+    cout << "ʼ MCL ...\n";
+    cout << "ϵ: " << options_.inflation << ", չݴ: " << options_.expansion
+        << ", ֵ: " << options_.prune_threshold << "\n";
+
+    SparseMatrix matrix = build_matrix();
+    iterations_ = 0;
+    chaos_ = 0.0;
+
+    while (iterations_ < options_.max_iterations) {
+        // չM^e = M * M * ... * Mһγ˷˳֦
+        SparseMatrix power = matrix;
+        double chaos = 0.0;
+        for (int e = 1; e < options_.expansion; ++e) {
+            power = multiply(power, matrix, e == options_.expansion - 1, chaos);
+        }
+        matrix = move(power);
+        ++iterations_;
+        chaos_ = chaos;
+        LSPQ_PROFILE_COUNT("mcl_nonzeros", matrix.nnz());
+        if (chaos < options_.chaos_threshold) break;
+    }
+
+    interpret(matrix);
+
+    cout << "MCL :  " << iterations_ << " , chaos = " << chaos_ << "\n";
+    if (chaos_ >= options_.chaos_threshold) {
+        cout << ": ﵽδ\n";
+    }
+    cout << "õ " << clusters_.size() << " \n";
+}
+
+// Ԫ (i, j) ʾڵ j  iߺϲذСڵ±
+void MarkovClustering::interpret(const SparseMatrix& matrix) {
+    const size_t n = graph_.node_count();
+    vector<uint32_t> parent(n);
+    for (uint32_t i = 0; i < n; ++i) parent[i] = i;
+    auto find_root = [&](uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (uint32_t j = 0; j < n; ++j) {
+        for (size_t e = matrix.offsets[j]; e < matrix.offsets[j + 1]; ++e) {
+            const uint32_t a = find_root(matrix.rows[e]);
+            const uint32_t b = find_root(j);
+            if (a != b) parent[max(a, b)] = min(a, b);
+        }
+    }
+
+    clusters_.clear();
+    vector<uint32_t> cluster_of_root(n, UINT32_MAX);
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t root = find_root(i);
+        if (cluster_of_root[root] == UINT32_MAX) {
+            cluster_of_root[root] = static_cast<uint32_t>(clusters_.size());
+            clusters_.emplace_back();
+        }
+        clusters_[cluster_of_root[root]].push_back(i);
+    }
+}
+
+vector<vector<string>> MarkovClustering::get_clusters() const {
+    const vector<string>& ids = graph_.node_ids();
+    vector<vector<string>> all_clusters;
+    for (const auto& cluster : clusters_) {
+        vector<string> names;
+        names.reserve(cluster.size());
+        for (uint32_t node : cluster) names.push_back(ids[node]);
+        all_clusters.push_back(move(names));
+    }
+    return all_clusters;
+}
+
+void MarkovClustering::export_clusters_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("MarkovClustering::export_clusters_to_single_file");
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    cout << " " << clusters_.size() << "  MCL ءڵļ: " << output_file_path << endl;
+
+    const vector<string>& ids = graph_.node_ids();
+    for (size_t i = 0; i < clusters_.size(); ++i) {
+        outfile << "Component " << (i + 1) << " (Nodes: " << clusters_[i].size() << "):\n";
+        for (uint32_t node : clusters_[i]) {
+            outfile << ids[node] << "\n";
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << " MCL ѵ: " << output_file_path << endl;
+}
+
+#endif // LSPQ_MARKOV_CLUSTERING_HPP
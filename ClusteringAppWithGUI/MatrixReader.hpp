@@ -0,0 +1,157 @@
+/**
+ ********************************************
+ * @file    :MatrixReader.hpp
+ * @author  :XXY
+ * @brief   :Row reader and memory accounting for matrix loading
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_MATRIX_READER_HPP
+#define LSPQ_MATRIX_READER_HPP
+
+#include <istream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <stdexcept>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// ͳƾķڼؽʱͼṹڴռ
+class CountingResource : public pmr::memory_resource {
+    pmr::memory_resource* upstream_;
+    size_t bytes_in_use_ = 0;
+    size_t peak_bytes_ = 0;
+    size_t allocations_ = 0;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = upstream_->allocate(bytes, alignment);
+        bytes_in_use_ += bytes;
+        peak_bytes_ = max(peak_bytes_, bytes_in_use_);
+        ++allocations_;
+        return p;
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+        bytes_in_use_ -= bytes;
+    }
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    explicit CountingResource(pmr::memory_resource* upstream = pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    size_t bytes_in_use() const { return bytes_in_use_; }
+    size_t peak_bytes() const { return peak_bytes_; }
+    size_t allocations() const { return allocations_; }
+};
+
+// жȡƱָľ
+// лֶڸ֮临ãֶ string_view ָл壻
+// ֶֻڲհףҪɾʱŰĸŽиõĵ
+// ֶ Graph::parse_line ͬɾпհֶַΡ
+class MatrixRowReader {
+    istream* in_;
+    char delimiter_;
+    string line_;
+    vector<string_view> tokens_;
+    char initial_scratch_[1024];
+    pmr::monotonic_buffer_resource scratch_;
+
+    void tokenize();
+
+public:
+    explicit MatrixRowReader(istream& in, char delimiter = '\t')
+        : in_(&in), delimiter_(delimiter), scratch_(initial_scratch_, sizeof(initial_scratch_)) {}
+    // ֻͨ assign_row зɵ÷У߳̽Ԥȶõп飩
+    explicit MatrixRowReader(char delimiter = '\t')
+        : in_(nullptr), delimiter_(delimiter), scratch_(initial_scratch_, sizeof(initial_scratch_)) {}
+
+    MatrixRowReader(const MatrixRowReader&) = delete;
+    MatrixRowReader& operator=(const MatrixRowReader&) = delete;
+
+    // ȡзһУļĩβʱ false
+    bool next_row();
+    // зָһУݽɶȡ
+    void assign_row(string&& line);
+
+    size_t size() const { return tokens_.size(); }
+    string_view operator[](size_t i) const { return tokens_[i]; }
+    const vector<string_view>& tokens() const { return tokens_; }
+
+    //  stod ͬת򣺽ܺϷǰ׺޷ת false׳ out_of_range
+    static bool to_double(string_view token, double& value);
+};
+
+/**************** Աʵ ****************/
+
+bool MatrixRowReader::next_row() {
+    if (!in_ || !getline(*in_, line_)) return false;
+    tokenize();
+    return true;
+}
+
+void MatrixRowReader::assign_row(string&& line) {
+    line_ = move(line);
+    tokenize();
+}
+
+void MatrixRowReader::tokenize() {
+    tokens_.clear();
+    scratch_.release();
+
+    const char* p = line_.data();
+    const char* const end = p + line_.size();
+    while (true) {
+        const char* field_end = static_cast<const char*>(memchr(p, delimiter_, end - p));
+        if (!field_end) field_end = end;
+
+        const char* b = p;
+        const char* e = field_end;
+        while (b < e && isspace(static_cast<unsigned char>(*b))) ++b;
+        while (e > b && isspace(static_cast<unsigned char>(e[-1]))) --e;
+
+        if (b < e) {
+            const char* inner = b;
+            while (inner < e && !isspace(static_cast<unsigned char>(*inner))) ++inner;
+            if (inner == e) {
+                tokens_.emplace_back(b, e - b);
+            }
+            else {
+                // ֶڲпհףȥհ׺ݣ '\0' β strtod ʹ
+                char* copy = static_cast<char*>(scratch_.allocate(e - b + 1, 1));
+                size_t n = 0;
+                for (const char* c = b; c < e; ++c) {
+                    if (!isspace(static_cast<unsigned char>(*c))) copy[n++] = *c;
+                }
+                copy[n] = '\0';
+                tokens_.emplace_back(copy, n);
+            }
+        }
+
+        if (field_end == end) break;
+        p = field_end + 1;
+    }
+}
+
+bool MatrixRowReader::to_double(string_view token, double& value) {
+    // ֶָ֮հ׻ '\0'strtod ֶĩβֹͣ
+    char* parsed_end = nullptr;
+    errno = 0;
+    value = strtod(token.data(), &parsed_end);
+    if (parsed_end == token.data()) return false;
+    if (errno == ERANGE) throw out_of_range("stod");
+    return true;
+}
+
+#endif // LSPQ_MATRIX_READER_HPP
@@ -0,0 +1,277 @@
+/**
+ ********************************************
+ * @file    :OutputCompare.hpp
+ * @author  :XXY
+ * @brief   :Order-insensitive comparison of exported result files
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_OUTPUT_COMPARE_HPP
+#define LSPQ_OUTPUT_COMPARE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+// Ƚеĸļ֮ͬĲ죨ݱͬ
+//   adjacency_matrix.txt                  죨жĽڵ˳
+//   network_for_cytoscape.txt             ˳ȡڽӱı˳
+//   all_components.txt                    ֧ͨı˳򡢷֧ڽڵ˳
+//   all_component_adjacency_matrices.txt  ͬϣ (нڵ, нڵ) ȽϵԪ
+struct FileComparison {
+    string file;
+    bool equal = true;
+    size_t differences = 0;
+    vector<string> details;  // ֻǰ˵
+};
+
+class OutputComparer {
+public:
+    static constexpr size_t kMaxDetails = 10;
+
+    using Cells = map<pair<string, string>, string>;
+    using Components = map<vector<string>, Cells>;  // Ľڵ㼯 -> ֧ڵľԪ
+
+    static FileComparison compare_adjacency_matrix(const string& expected_path, const string& actual_path);
+    static FileComparison compare_edge_list(const string& expected_path, const string& actual_path);
+    static FileComparison compare_components(const string& expected_path, const string& actual_path);
+    static FileComparison compare_component_matrices(const string& expected_path, const string& actual_path);
+
+    // ȽĿ¼µȫļ
+    static vector<FileComparison> compare_directories(const string& expected_dir, const string& actual_dir);
+    static bool all_equal(const vector<FileComparison>& comparisons);
+    static void print(const vector<FileComparison>& comparisons);
+
+private:
+    static ifstream open(const string& path);
+    static bool read_line(istream& in, string& line);
+    static vector<string> split_tabs(const string& line);
+    static void note(FileComparison& result, const string& detail);
+    // ȡԡ\t1\t2...ͷÿС\tֵ...ľ飬лļĩβ
+    static bool read_matrix_block(istream& in, const string& header, Cells& cells, vector<string>& nodes);
+    static Components read_component_blocks(const string& path, bool with_matrix);
+    static void compare_cells(FileComparison& result, const Cells& expected, const Cells& actual);
+    static string join(const vector<string>& nodes);
+};
+
+/**************** Աʵ ****************/
+
+ifstream OutputComparer::open(const string& path) {
+    ifstream file(path);
+    if (!file) throw runtime_error("޷ļ: " + path);
+    return file;
+}
+
+// ͬʱ LF  CRLF УֿбĽļΪ CRLF
+bool OutputComparer::read_line(istream& in, string& line) {
+    if (!getline(in, line)) return false;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+vector<string> OutputComparer::split_tabs(const string& line) {
+    vector<string> fields;
+    size_t start = 0;
+    while (true) {
+        const size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == string::npos ? string::npos : tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+void OutputComparer::note(FileComparison& result, const string& detail) {
+    result.equal = false;
+    ++result.differences;
+    if (result.details.size() < kMaxDetails) result.details.push_back(detail);
+}
+
+string OutputComparer::join(const vector<string>& nodes) {
+    string text;
+    for (size_t i = 0; i < nodes.size() && i < 3; ++i) text += (i ? "," : "") + nodes[i];
+    if (nodes.size() > 3) text += ",...(" + to_string(nodes.size()) + ")";
+    return text;
+}
+
+bool OutputComparer::read_matrix_block(istream& in, const string& header, Cells& cells, vector<string>& nodes) {
+    vector<string> columns = split_tabs(header);
+    if (columns.empty() || !columns[0].empty()) return false;
+    columns.erase(columns.begin());
+    nodes = columns;
+
+    string line;
+    while (read_line(in, line) && !line.empty()) {
+        vector<string> fields = split_tabs(line);
+        if (fields.size() != columns.size() + 1) return false;
+        for (size_t j = 0; j < columns.size(); ++j) {
+            cells[{ fields[0], columns[j] }] = fields[j + 1];
+        }
+    }
+    return true;
+}
+
+void OutputComparer::compare_cells(FileComparison& result, const Cells& expected, const Cells& actual) {
+    auto e = expected.begin();
+    auto a = actual.begin();
+    while (e != expected.end() || a != actual.end()) {
+        if (a == actual.end() || (e != expected.end() && e->first < a->first)) {
+            note(result, "ȱٵԪ " + e->first.first + " / " + e->first.second);
+            ++e;
+        }
+        else if (e == expected.end() || a->first < e->first) {
+            note(result, "Ԫ " + a->first.first + " / " + a->first.second);
+            ++a;
+        }
+        else {
+            if (e->second != a->second) {
+                note(result, "Ԫ " + e->first.first + " / " + e->first.second +
+                    " Ԥ " + e->second + " ʵ " + a->second);
+            }
+            ++e;
+            ++a;
+        }
+    }
+}
+
+FileComparison OutputComparer::compare_adjacency_matrix(const string& expected_path, const string& actual_path) {
+    FileComparison result;
+    result.file = "adjacency_matrix.txt";
+    ifstream expected = open(expected_path);
+    ifstream actual = open(actual_path);
+
+    string e, a;
+    size_t line = 0;
+    while (true) {
+        const bool has_e = read_line(expected, e);
+        const bool has_a = read_line(actual, a);
+        if (!has_e && !has_a) break;
+        ++line;
+        if (has_e != has_a) {
+            note(result, "ͬӵ " + to_string(line) + " пʼ");
+            break;
+        }
+        if (e != a) note(result, " " + to_string(line) + " вͬ");
+    }
+    return result;
+}
+
+FileComparison OutputComparer::compare_edge_list(const string& expected_path, const string& actual_path) {
+    FileComparison result;
+    result.file = "network_for_cytoscape.txt";
+
+    auto read_lines = [](const string& path, string& header) {
+        ifstream file = open(path);
+        read_line(file, header);
+        vector<string> lines;
+        string line;
+        while (read_line(file, line)) {
+            if (!line.empty()) lines.push_back(line);
+        }
+        sort(lines.begin(), lines.end());
+        return lines;
+    };
+
+    string expected_header, actual_header;
+    const vector<string> expected = read_lines(expected_path, expected_header);
+    const vector<string> actual = read_lines(actual_path, actual_header);
+    if (expected_header != actual_header) note(result, "ͷͬ");
+
+    vector<string> missing, extra;
+    set_difference(expected.begin(), expected.end(), actual.begin(), actual.end(), back_inserter(missing));
+    set_difference(actual.begin(), actual.end(), expected.begin(), expected.end(), back_inserter(extra));
+    for (const auto& line : missing) note(result, "ȱٱ: " + line);
+    for (const auto& line : extra) note(result, ": " + line);
+    return result;
+}
+
+OutputComparer::Components OutputComparer::read_component_blocks(const string& path, bool with_matrix) {
+    ifstream file = open(path);
+    Components components;
+    string line;
+    while (read_line(file, line)) {
+        if (line.compare(0, 10, "Component ") != 0) continue;
+
+        vector<string> nodes;
+        Cells cells;
+        if (with_matrix) {
+            string header;
+            read_line(file, header);
+            if (!read_matrix_block(file, header, cells, nodes)) {
+                throw runtime_error("ʽ: " + path + " " + line);
+            }
+        }
+        else {
+            while (read_line(file, line) && !line.empty()) nodes.push_back(line);
+        }
+        sort(nodes.begin(), nodes.end());
+        components[nodes] = move(cells);
+    }
+    return components;
+}
+
+FileComparison OutputComparer::compare_components(const string& expected_path, const string& actual_path) {
+    FileComparison result;
+    result.file = "all_components.txt";
+    const Components expected = read_component_blocks(expected_path, false);
+    const Components actual = read_component_blocks(actual_path, false);
+
+    for (const auto& entry : expected) {
+        if (!actual.count(entry.first)) note(result, "ȱ֧ͨ {" + join(entry.first) + "}");
+    }
+    for (const auto& entry : actual) {
+        if (!expected.count(entry.first)) note(result, "֧ͨ {" + join(entry.first) + "}");
+    }
+    return result;
+}
+
+FileComparison OutputComparer::compare_component_matrices(const string& expected_path, const string& actual_path) {
+    FileComparison result;
+    result.file = "all_component_adjacency_matrices.txt";
+    const Components expected = read_component_blocks(expected_path, true);
+    const Components actual = read_component_blocks(actual_path, true);
+
+    for (const auto& entry : expected) {
+        auto found = actual.find(entry.first);
+        if (found == actual.end()) note(result, "ȱ֧ͨ {" + join(entry.first) + "}");
+        else compare_cells(result, entry.second, found->second);
+    }
+    for (const auto& entry : actual) {
+        if (!expected.count(entry.first)) note(result, "֧ͨ {" + join(entry.first) + "}");
+    }
+    return result;
+}
+
+vector<FileComparison> OutputComparer::compare_directories(const string& expected_dir, const string& actual_dir) {
+    auto in = [](const string& dir, const string& name) { return dir + "/" + name; };
+    return {
+        compare_adjacency_matrix(in(expected_dir, "adjacency_matrix.txt"), in(actual_dir, "adjacency_matrix.txt")),
+        compare_components(in(expected_dir, "all_components.txt"), in(actual_dir, "all_components.txt")),
+        compare_edge_list(in(expected_dir, "network_for_cytoscape.txt"), in(actual_dir, "network_for_cytoscape.txt")),
+        compare_component_matrices(in(expected_dir, "all_component_adjacency_matrices.txt"),
+            in(actual_dir, "all_component_adjacency_matrices.txt")),
+    };
+}
+
+bool OutputComparer::all_equal(const vector<FileComparison>& comparisons) {
+    return all_of(comparisons.begin(), comparisons.end(), [](const FileComparison& c) { return c.equal; });
+}
+
+void OutputComparer::print(const vector<FileComparison>& comparisons) {
+    for (const auto& c : comparisons) {
+        cout << "    " << c.file << ": " << (c.equal ? "һ" : "һ (" + to_string(c.differences) + " )") << "\n";
+        for (const auto& detail : c.details) cout << "      " << detail << "\n";
+    }
+}
+
+#endif // LSPQ_OUTPUT_COMPARE_HPP
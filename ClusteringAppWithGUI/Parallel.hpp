@@ -0,0 +1,114 @@
+/**
+ ********************************************
+ * @file    :Parallel.hpp
+ * @author  :XXY
+ * @brief   :Minimal block-parallel loop helpers and a bounded queue
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_PARALLEL_HPP
+#define LSPQ_PARALLEL_HPP
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <algorithm>
+
+using namespace std;
+
+// 0 ʾʹȫӲ߳
+inline size_t resolve_thread_count(size_t requested) {
+    if (requested > 0) return requested;
+    const unsigned hw = thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+//  [0, count) гɴСΪ block Ŀ飬 threads ̶̬߳ȡ
+// f(begin, end, worker) ڹִ߳Уһ߳׳ĵһ쳣ڻϺ׳
+template <typename F>
+void parallel_for_blocks(size_t count, size_t block, size_t threads, F&& f) {
+    if (count == 0) return;
+    block = max<size_t>(block, 1);
+    const size_t blocks = (count + block - 1) / block;
+    threads = min(resolve_thread_count(threads), blocks);
+
+    if (threads == 1) {
+        for (size_t b = 0; b < blocks; ++b) {
+            f(b * block, min(count, (b + 1) * block), size_t(0));
+        }
+        return;
+    }
+
+    atomic<size_t> next_block(0);
+    exception_ptr error;
+    mutex error_mutex;
+
+    auto worker = [&](size_t worker_index) {
+        try {
+            for (size_t b = next_block++; b < blocks; b = next_block++) {
+                f(b * block, min(count, (b + 1) * block), worker_index);
+            }
+        }
+        catch (...) {
+            lock_guard<mutex> lock(error_mutex);
+            if (!error) error = current_exception();
+            next_block = blocks; // ߳̾
+        }
+    };
+
+    vector<thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    if (error) rethrow_exception(error);
+}
+
+// нУʱߵȴʱߵȴ
+// close() ֮ push  falsepop ȡʣԪغ󷵻 false
+template <typename T>
+class BoundedQueue {
+    mutex mutex_;
+    condition_variable not_full_;
+    condition_variable not_empty_;
+    deque<T> items_;
+    size_t capacity_;
+    bool closed_ = false;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity) {}
+
+    bool push(T item) {
+        unique_lock<mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        item = move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> lock(mutex_);
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+};
+
+#endif // LSPQ_PARALLEL_HPP
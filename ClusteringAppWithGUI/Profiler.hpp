@@ -0,0 +1,281 @@
+/**
+ ********************************************
+ * @file    :Profiler.hpp
+ * @author  :XXY
+ * @brief   :Per-phase timers, counters and RSS sampling
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_PROFILER_HPP
+#define LSPQ_PROFILER_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+//  windows.h  rpcndr.hе ::byte  using namespace std ֮ std::byte ͻC2872
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+using namespace std;
+
+// 
+//  LSPQ_ENABLE_PROFILING  LSPQ_PROFILE_SCOPE / LSPQ_PROFILE_COUNT ŻչΪʵʴ룬
+// Ϊ䣬ûκοʱ enable() --profile Ż¼
+// Ĭ϶˸ú꣺δʱÿʱֻһα־λжϡ
+//
+// ÷
+//     LSPQ_PROFILE_SCOPE("perform_neighborhood_analysis");
+//     LSPQ_PROFILE_COUNT("edges_cut", cuts);
+class Profiler {
+public:
+    struct Phase {
+        string name;
+        int depth = 0;      // ͬһ߳ڵǶײ
+        int thread = 0;     // ߳ţ״μ¼Ⱥ 0 ʼ
+        double start_ms = 0.0;
+        double duration_ms = 0.0;
+        size_t rss_bytes = 0;
+        size_t peak_rss_bytes = 0;
+    };
+
+private:
+    using Clock = chrono::steady_clock;
+
+    atomic<bool> enabled_{ false };   // Scope  add ڼǰȡ
+    atomic<int> next_thread_{ 0 };
+    Clock::time_point origin_ = Clock::now();
+    vector<Phase> phases_;
+    map<string, unsigned long long> counters_;
+    mutex mutex_;
+
+    Profiler() = default;
+
+    // Ƕײ̷ֱ߳ҵʽ湤̵߳Ȳд򿪵以
+    static int& thread_depth() {
+        static thread_local int depth = 0;
+        return depth;
+    }
+    int thread_index() {
+        static thread_local int index = next_thread_++;
+        return index;
+    }
+
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    bool enabled() const { return enabled_.load(); }
+    void enable() {
+        enabled_ = true;
+        origin_ = Clock::now();
+    }
+
+    double elapsed_ms() const {
+        return chrono::duration<double, milli>(Clock::now() - origin_).count();
+    }
+
+    // ʱ䣺ʱʼʱ¼
+    class Scope {
+        Profiler* profiler_;
+        size_t index_ = 0;
+
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    void add(const char* counter, unsigned long long value);
+
+    static size_t current_rss_bytes();
+    static size_t peak_rss_bytes();
+
+    // ȡ --profile  --profile=<·>ǰƱԭλ塣
+    // ҵʱر·δָʱΪ default_path򷵻ؿմ
+    string consume_flag(int& argc, char** argv, const string& default_path);
+
+    void print_summary() const;
+    void write_report(const string& output_path) const;
+};
+
+/**************** Աʵ ****************/
+
+Profiler::Scope::Scope(const char* name) : profiler_(nullptr) {
+    Profiler& p = Profiler::instance();
+    if (!p.enabled_) return;
+    profiler_ = &p;
+    Phase phase;
+    phase.name = name;
+    phase.depth = thread_depth()++;
+    phase.thread = p.thread_index();
+    phase.start_ms = p.elapsed_ms();
+    lock_guard<mutex> lock(p.mutex_);
+    index_ = p.phases_.size();
+    p.phases_.push_back(move(phase));
+}
+
+Profiler::Scope::~Scope() {
+    if (!profiler_) return;
+    const double now = profiler_->elapsed_ms();
+    const size_t rss = current_rss_bytes();
+    const size_t peak = peak_rss_bytes();
+    lock_guard<mutex> lock(profiler_->mutex_);
+    Phase& phase = profiler_->phases_[index_];
+    phase.duration_ms = now - phase.start_ms;
+    phase.rss_bytes = rss;
+    phase.peak_rss_bytes = peak;
+    --thread_depth();
+}
+
+void Profiler::add(const char* counter, unsigned long long value) {
+    if (!enabled_) return;
+    lock_guard<mutex> lock(mutex_);
+    counters_[counter] += value;
+}
+
+size_t Profiler::current_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#else
+    long pages = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        long total = 0;
+        if (fscanf(statm, "%ld %ld", &total, &pages) != 2) pages = 0;
+        fclose(statm);
+    }
+    return static_cast<size_t>(pages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t Profiler::peak_rss_bytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+string Profiler::consume_flag(int& argc, char** argv, const string& default_path) {
+    string path;
+    int write = 1;
+    for (int read = 1; read < argc; ++read) {
+        const char* arg = argv[read];
+        if (strcmp(arg, "--profile") == 0) {
+            path = default_path;
+        }
+        else if (strncmp(arg, "--profile=", 10) == 0) {
+            path = arg + 10;
+            if (path.empty()) path = default_path;
+        }
+        else {
+            argv[write++] = argv[read];
+        }
+    }
+    argc = write;
+    argv[argc] = nullptr;
+#ifndef LSPQ_ENABLE_PROFILING
+    if (!path.empty()) {
+        cerr << ": ʱδ LSPQ_ENABLE_PROFILING--profile " << endl;
+        return string();
+    }
+#endif
+    if (!path.empty()) enable();
+    return path;
+}
+
+void Profiler::print_summary() const {
+    if (!enabled_) return;
+    cout << ":\n";
+    for (const auto& phase : phases_) {
+        cout << string(2 * (phase.depth + 1), ' ');
+        if (phase.thread != 0) cout << "[߳ " << phase.thread << "] ";
+        cout << phase.name << ": "
+            << phase.duration_ms << " ms, RSS " << phase.rss_bytes / (1024 * 1024) << " MB\n";
+    }
+    for (const auto& counter : counters_) {
+        cout << "  " << counter.first << " = " << counter.second << "\n";
+    }
+    cout << "  ֵڴ: " << peak_rss_bytes() / (1024 * 1024) << " MB\n";
+}
+
+// ɶ׶α棨JSON
+void Profiler::write_report(const string& output_path) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "{\n  \"total_ms\": " << elapsed_ms() << ",\n";
+    outfile << "  \"peak_rss_bytes\": " << peak_rss_bytes() << ",\n";
+    outfile << "  \"phases\": [";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        const Phase& phase = phases_[i];
+        outfile << (i ? "," : "") << "\n    {\"name\": \"" << phase.name << "\", \"thread\": " << phase.thread
+            << ", \"depth\": " << phase.depth
+            << ", \"start_ms\": " << phase.start_ms << ", \"duration_ms\": " << phase.duration_ms
+            << ", \"rss_bytes\": " << phase.rss_bytes << ", \"peak_rss_bytes\": " << phase.peak_rss_bytes << "}";
+    }
+    outfile << "\n  ],\n  \"counters\": {";
+    bool first = true;
+    for (const auto& counter : counters_) {
+        outfile << (first ? "" : ",") << "\n    \"" << counter.first << "\": " << counter.second;
+        first = false;
+    }
+    outfile << "\n  }\n}\n";
+
+    outfile.close();
+    cout << "ѵ: " << output_path << endl;
+}
+
+#define LSPQ_PROFILE_CONCAT_INNER(a, b) a##b
+#define LSPQ_PROFILE_CONCAT(a, b) LSPQ_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef LSPQ_ENABLE_PROFILING
+#define LSPQ_PROFILE_SCOPE(name) Profiler::Scope LSPQ_PROFILE_CONCAT(lspq_profile_scope_, __LINE__)(name)
+#define LSPQ_PROFILE_COUNT(name, value) Profiler::instance().add(name, static_cast<unsigned long long>(value))
+#else
+#define LSPQ_PROFILE_SCOPE(name) ((void)0)
+#define LSPQ_PROFILE_COUNT(name, value) ((void)sizeof(value))
+#endif
+
+#endif // LSPQ_PROFILER_HPP
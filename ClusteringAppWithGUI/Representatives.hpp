@@ -0,0 +1,349 @@
+/**
+ ********************************************
+ * @file    :Representatives.hpp
+ * @author  :XXY
+ * @brief   :Per-component representative selection on pre-pruning weights
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_REPRESENTATIVES_HPP
+#define LSPQ_REPRESENTATIVES_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <iomanip>
+#include <cmath>
+
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+enum class RepresentativeKind { Medoid, MaxDegree, Centroid };
+
+struct RepresentativeOptions {
+    RepresentativeKind list_kind = RepresentativeKind::Medoid;  // д뾫 ID бĴ
+    size_t threads = 0;  // 0 ʾȫӲ߳
+};
+
+// һִ֧֧ͨ±꣩
+struct Representative {
+    size_t nodes = 0;
+    uint32_t medoid = 0;         // Աԭʼƶ֮
+    double medoid_mean = 0.0;    // medoid Աƽƶ
+    uint32_t max_degree = 0;     // ֦ھ
+    size_t degree = 0;
+    uint32_t centroid = 0;       // ƶӽ֧ƽ
+    double centroid_rms = 0.0;   // ƽľ
+};
+
+// Ϊÿ֧ͨѡСƶʹü֦ǰԭʼȨأ
+// δ compact()  CsrGraph ԱߵȨأֱӶȡ
+//  Graph֦ʱɾȨأѹ CsrGraphɨԴ
+// ÿֻ֧ O(s) ۼٶ ss Ӿ
+//  s Ϊ֧ģw_ij ΪԱƶȣԽߣ
+//   medoid   ʹ _j w_ij 
+//   centroid ʹ _j (w_ij - m_j)^2 С m_j = _k w_kj / (s - 1)
+// centroid ľ밴  w_ij^2 - 2  w_ij m_j + _{ji} m_j^2 չ
+// һõкͣ mƽͣڶõ m ڻ
+// ֧֮䲢м㣻ͬʱȡ֧±Сߡ
+class RepresentativeSelector {
+    struct Component {
+        vector<string> names;
+        vector<size_t> degree;
+        vector<uint32_t> nodes;  // CsrGraph еĽڵ±ֱ꣨ӶȡԭʼȨʱʹã
+        // Դʽۼӵ֧±꣩
+        vector<double> row_sum;     // _j w_ij
+        vector<double> square_sum;  // _j w_ij^2
+        vector<double> cross_sum;   // _j w_ij m_j
+    };
+
+    RepresentativeOptions options_;
+    const CsrGraph* csr_ = nullptr;
+    vector<uint32_t> local_;     // CsrGraph ڵ± -> ֧±
+    vector<uint32_t> owner_;     // CsrGraph ڵ± -> ֧
+    vector<Component> components_;
+    vector<Representative> representatives_;
+
+    void load_sums(const string& matrix_path);
+    // ɨһԴ󣬶ͬһ֧ڵÿԳԱ f(֧, i, k, w_ik)
+    template <typename F>
+    void scan_matrix(const string& matrix_path, F&& f) const;
+    Representative select(const Component& component, const vector<double>& row_sum,
+        const vector<double>& square_sum, const vector<double>& cross_sum) const;
+
+public:
+    // ֱʹ CsrGraph бԭʼȨأҪδ compact()
+    explicit RepresentativeSelector(const CsrGraph& graph, const RepresentativeOptions& options = RepresentativeOptions());
+    // Դ¶ȡԭʼȨ
+    RepresentativeSelector(const CsrGraph& graph, const string& matrix_path,
+        const RepresentativeOptions& options = RepresentativeOptions());
+    RepresentativeSelector(const Graph& graph, const string& matrix_path,
+        const RepresentativeOptions& options = RepresentativeOptions());
+
+    void run();
+    const vector<Representative>& representatives() const { return representatives_; }
+    const string& name(size_t component, uint32_t local) const { return components_[component].names[local]; }
+
+    // ÿ֧ͨһ
+    void export_representatives_tsv(const string& output_path) const;
+    //  ID бÿ֧ͨһ options.list_kind ָĴֱڴ FASTA гȡ
+    void export_representative_ids(const string& output_path) const;
+};
+
+/**************** Աʵ ****************/
+
+RepresentativeSelector::RepresentativeSelector(const CsrGraph& graph, const RepresentativeOptions& options)
+    : options_(options), csr_(&graph) {
+    if (!graph.has_original_weights()) {
+        throw runtime_error("CsrGraph ѹ֦ǰȨزãͬʱṩԴ·");
+    }
+    const vector<vector<uint32_t>> components = graph.component_indices();
+    local_.assign(graph.node_count(), 0);
+    owner_.assign(graph.node_count(), 0);
+    components_.resize(components.size());
+    for (size_t c = 0; c < components.size(); ++c) {
+        Component& component = components_[c];
+        component.nodes = components[c];
+        for (uint32_t i = 0; i < component.nodes.size(); ++i) {
+            const uint32_t node = component.nodes[i];
+            local_[node] = i;
+            owner_[node] = static_cast<uint32_t>(c);
+            component.names.push_back(graph.node_ids()[node]);
+            component.degree.push_back(graph.degree(node));
+        }
+    }
+}
+
+RepresentativeSelector::RepresentativeSelector(const CsrGraph& graph, const string& matrix_path,
+    const RepresentativeOptions& options) : options_(options) {
+    for (const auto& nodes : graph.component_indices()) {
+        Component component;
+        for (uint32_t node : nodes) {
+            component.names.push_back(graph.node_ids()[node]);
+            component.degree.push_back(graph.degree(node));
+        }
+        components_.push_back(move(component));
+    }
+    load_sums(matrix_path);
+}
+
+RepresentativeSelector::RepresentativeSelector(const Graph& graph, const string& matrix_path,
+    const RepresentativeOptions& options) : options_(options) {
+    for (auto& names : graph.get_connected_components()) {
+        Component component;
+        for (const string& name : names) component.degree.push_back(graph.neighbor_edges(name).size());
+        component.names = move(names);
+        components_.push_back(move(component));
+    }
+    load_sums(matrix_path);
+}
+
+template <typename F>
+void RepresentativeSelector::scan_matrix(const string& matrix_path, F&& f) const {
+    MatrixInputStream file(matrix_path);
+    if (!file) throw runtime_error("޷ļ: " + matrix_path);
+
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) throw runtime_error("ļΪ");
+    vector<string> header;
+    header.reserve(reader.size());
+    for (string_view id : reader.tokens()) header.emplace_back(id);
+
+    // ڵ ID -> (֧, ֧±)ÿ֧¼Աڵ
+    unordered_map<string, pair<uint32_t, uint32_t>> position;
+    vector<vector<uint32_t>> columns(components_.size());
+    for (uint32_t c = 0; c < components_.size(); ++c) {
+        const auto& names = components_[c].names;
+        for (uint32_t i = 0; i < names.size(); ++i) position.emplace(names[i], make_pair(c, i));
+        if (names.size() > 1) columns[c].assign(names.size(), 0);
+    }
+    for (uint32_t j = 0; j < header.size(); ++j) {
+        auto found = position.find(header[j]);
+        if (found == position.end()) throw runtime_error("ԴеĽڵ㲻ͼ: " + header[j]);
+        if (!columns[found->second.first].empty()) columns[found->second.first][found->second.second] = j;
+    }
+    if (header.size() != position.size()) throw runtime_error("ԴͼĽڵһ");
+
+    for (size_t i = 0; i < header.size(); ++i) {
+        if (!reader.next_row()) throw runtime_error("ȱٵ" + to_string(i + 1) + "");
+        if (reader.size() != header.size() + 1) {
+            throw runtime_error("" + to_string(i + 1) + "ƥ䣬Ԥ: " +
+                to_string(header.size() + 1) + " ʵ: " + to_string(reader.size()));
+        }
+        if (reader[0] != string_view(header[i])) {
+            throw runtime_error("ڵIDƥ:  " + to_string(i + 1) +
+                " Ԥ " + header[i] + " ʵ " + string(reader[0]));
+        }
+
+        const auto& where = position.at(header[i]);
+        const vector<uint32_t>& member_columns = columns[where.first];
+        for (uint32_t k = 0; k < member_columns.size(); ++k) {
+            if (k == where.second) continue;
+            const uint32_t j = member_columns[k];
+            double weight;
+            if (!MatrixRowReader::to_double(reader[j + 1], weight)) {
+                throw runtime_error("" + to_string(i + 1) + "е" +
+                    to_string(j + 2) + "ֵЧ: " + string(reader[j + 1]));
+            }
+            f(where.first, where.second, k, weight);
+        }
+    }
+}
+
+// ɨԴΪÿԱۼк͡ƽԼ֧ƽڻ
+void RepresentativeSelector::load_sums(const string& matrix_path) {
+    LSPQ_PROFILE_SCOPE("RepresentativeSelector::load_sums");
+    size_t members = 0;
+    for (Component& component : components_) {
+        const size_t s = component.names.size();
+        if (s < 2) continue;
+        component.row_sum.assign(s, 0.0);
+        component.square_sum.assign(s, 0.0);
+        component.cross_sum.assign(s, 0.0);
+        members += s;
+    }
+
+    ostringstream note;
+    note << fixed << setprecision(1) << "ɨԴۼӷ֧ԭʼȨأۼռ "
+        << members * 3 * sizeof(double) / (1024.0 * 1024.0) << " MB\n";
+    cout << note.str();
+
+    scan_matrix(matrix_path, [&](uint32_t c, uint32_t i, uint32_t, double w) {
+        Component& component = components_[c];
+        component.row_sum[i] += w;
+        component.square_sum[i] += w * w;
+    });
+    scan_matrix(matrix_path, [&](uint32_t c, uint32_t i, uint32_t k, double w) {
+        Component& component = components_[c];
+        component.cross_sum[i] += w * (component.row_sum[k] / (component.names.size() - 1));
+    });
+}
+
+Representative RepresentativeSelector::select(const Component& component, const vector<double>& row_sum,
+    const vector<double>& square_sum, const vector<double>& cross_sum) const {
+    const size_t s = component.names.size();
+    Representative result;
+    result.nodes = s;
+    result.degree = s ? component.degree[0] : 0;
+    if (s < 2) return result;
+
+    const double others = static_cast<double>(s - 1);
+    double mean_square_sum = 0.0;
+    for (uint32_t k = 0; k < s; ++k) {
+        const double m = row_sum[k] / others;
+        mean_square_sum += m * m;
+    }
+    vector<double> distance(s, 0.0);
+    for (uint32_t i = 0; i < s; ++i) {
+        const double m = row_sum[i] / others;
+        // չʽС 0
+        distance[i] = max(square_sum[i] - 2.0 * cross_sum[i] + (mean_square_sum - m * m), 0.0);
+    }
+
+    for (uint32_t i = 1; i < s; ++i) {
+        if (row_sum[i] > row_sum[result.medoid]) result.medoid = i;
+        if (distance[i] < distance[result.centroid]) result.centroid = i;
+        const size_t d = component.degree[i];
+        const size_t best = component.degree[result.max_degree];
+        if (d > best || (d == best && row_sum[i] > row_sum[result.max_degree])) result.max_degree = i;
+    }
+    result.medoid_mean = row_sum[result.medoid] / others;
+    result.degree = component.degree[result.max_degree];
+    result.centroid_rms = sqrt(distance[result.centroid] / others);
+    return result;
+}
+
+void RepresentativeSelector::run() {
+    LSPQ_PROFILE_SCOPE("RepresentativeSelector::run");
+    cout << "ʼѡȡ֧ͨ...\n";
+    representatives_.assign(components_.size(), Representative());
+
+    parallel_for_blocks(components_.size(), 1, options_.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t c = begin; c < end; ++c) {
+            const Component& component = components_[c];
+            if (!csr_) {
+                representatives_[c] = select(component, component.row_sum, component.square_sum, component.cross_sum);
+                continue;
+            }
+
+            // Դ·ͬۼӣֻȨֱȡ CsrGraph
+            const size_t s = component.names.size();
+            vector<double> row_sum(s, 0.0), square_sum(s, 0.0), cross_sum(s, 0.0);
+            const double others = s > 1 ? static_cast<double>(s - 1) : 1.0;
+            for (uint32_t i = 0; i < s; ++i) {
+                csr_->for_each_original_neighbor(component.nodes[i], [&](uint32_t target, double w) {
+                    if (owner_[target] != c) return;
+                    row_sum[i] += w;
+                    square_sum[i] += w * w;
+                });
+            }
+            for (uint32_t i = 0; i < s; ++i) {
+                csr_->for_each_original_neighbor(component.nodes[i], [&](uint32_t target, double w) {
+                    if (owner_[target] == c) cross_sum[i] += w * (row_sum[local_[target]] / others);
+                });
+            }
+            representatives_[c] = select(component, row_sum, square_sum, cross_sum);
+        }
+    });
+
+    size_t agree = 0;
+    for (const auto& r : representatives_) {
+        if (r.medoid == r.max_degree && r.medoid == r.centroid) ++agree;
+    }
+    cout << "Ϊ " << representatives_.size() << " ֧ͨѡȡ " << agree
+        << " ִ֧ͬ\n";
+}
+
+void RepresentativeSelector::export_representatives_tsv(const string& output_path) const {
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "component\tnodes\tmedoid\tmedoid_mean_identity\tmax_degree\tdegree\tcentroid\tcentroid_rms_distance\n";
+    for (size_t c = 0; c < representatives_.size(); ++c) {
+        const Representative& r = representatives_[c];
+        outfile << (c + 1) << "\t" << r.nodes << "\t"
+            << name(c, r.medoid) << "\t" << r.medoid_mean << "\t"
+            << name(c, r.max_degree) << "\t" << r.degree << "\t"
+            << name(c, r.centroid) << "\t" << r.centroid_rms << "\n";
+    }
+
+    outfile.close();
+    cout << "ѵ: " << output_path << endl;
+}
+
+void RepresentativeSelector::export_representative_ids(const string& output_path) const {
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    for (size_t c = 0; c < representatives_.size(); ++c) {
+        const Representative& r = representatives_[c];
+        switch (options_.list_kind) {
+        case RepresentativeKind::Medoid: outfile << name(c, r.medoid) << "\n"; break;
+        case RepresentativeKind::MaxDegree: outfile << name(c, r.max_degree) << "\n"; break;
+        case RepresentativeKind::Centroid: outfile << name(c, r.centroid) << "\n"; break;
+        }
+    }
+
+    outfile.close();
+    cout << " ID б" << representatives_.size() << " ѵ: " << output_path << endl;
+}
+
+#endif // LSPQ_REPRESENTATIVES_HPP
@@ -0,0 +1,570 @@
+/**
+ ********************************************
+ * @file    :StreamingGraph.hpp
+ * @author  :XXY
+ * @brief   :Out-of-core neighborhood analysis for matrices larger than RAM
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_STREAMING_GRAPH_HPP
+#define LSPQ_STREAMING_GRAPH_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <limits>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+
+#include "MatrixReader.hpp"
+#include "CompressedInput.hpp"
+#include "ExternalSort.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+struct StreamingOptions {
+    size_t memory_budget_mb = 1024;  // п߻ڴ
+    string temp_dir;                 // δλãΪʱʹϵͳʱĿ¼
+    size_t threads = 0;              // п߳0 ʾȫӲ߳
+};
+
+// ģʽͼǰпʽȡֻÿڵֵͲ鼯
+// дڴʱд̣
+//
+//  Graph::perform_neighborhood_analysis ȼ۵ݣڵ㰴˳ i ڵ㴦ʱ
+//  j > i ı߶ڣ j < i ıߵҽ w >= t_j ʱڣt_j Ϊڵ j õֵ
+// ĽڵΪ˶ i ʱȷֵ𣬲ұ (j, i) 
+// ҽ w >= t_j  w >= t_iҪԳƣǵĹϣУ֤
+//
+// ڴ棺п߻ memory_budget_mb Լڵ״̬Լ 40 ֽ/ڵ㣬ޡ
+class StreamingGraph {
+    struct EdgeRecord {
+        uint32_t source;
+        uint32_t target;
+        double weight;
+    };
+
+    struct BySource {
+        bool operator()(const EdgeRecord& a, const EdgeRecord& b) const {
+            return a.source != b.source ? a.source < b.source : a.target < b.target;
+        }
+    };
+
+    struct ByComponent {
+        const vector<uint32_t>* component;
+        bool operator()(const EdgeRecord& a, const EdgeRecord& b) const {
+            const uint32_t ca = (*component)[a.source];
+            const uint32_t cb = (*component)[b.source];
+            if (ca != cb) return ca < cb;
+            return BySource()(a, b);
+        }
+    };
+
+    string dataPath_;
+    StreamingOptions options_;
+    string temp_dir_;
+    vector<string> nodeIds_;
+
+    // 
+    vector<double> thresholds_;    // ĽڵΪ
+    vector<uint32_t> degree_;      // ֦Ķ
+    vector<uint32_t> component_;   // ڵ -> ֧ͨţ֧С±
+    vector<size_t> component_offsets_;
+    vector<uint32_t> component_nodes_;
+    unique_ptr<ExternalSorter<EdgeRecord, BySource>> edges_;  // ÿߵ
+    bool analyzed_ = false;
+
+    size_t budget_bytes() const { return options_.memory_budget_mb * 1024 * 1024; }
+    size_t block_rows() const;
+    void require_analysis() const;
+
+    // пȡпڲнк˳ f(i, row)
+    template <typename F>
+    void for_each_row(F&& f) const;
+    static uint64_t cell_hash(uint64_t a, uint64_t b, double weight);
+
+    static uint32_t find_root(vector<uint32_t>& parent, uint32_t x);
+    void build_components(vector<uint32_t>& parent);
+
+public:
+    // ֻȡеĽڵIDڷʱʽȡ
+    explicit StreamingGraph(const string& dataPath, const StreamingOptions& options = StreamingOptions());
+    ~StreamingGraph();
+    StreamingGraph(const StreamingGraph&) = delete;
+    StreamingGraph& operator=(const StreamingGraph&) = delete;
+
+    size_t node_count() const { return nodeIds_.size(); }
+    size_t edge_count() const { return edges_ ? edges_->size() / 2 : 0; }
+    size_t spilled_runs() const { return edges_ ? edges_->run_count() : 0; }
+
+    void validate_symmetry() const;
+    void print_summary() const;
+    void perform_neighborhood_analysis(double small_threshold, double medium_threshold,
+        double large_threshold, size_t min_neighbors);
+    int count_connected_components() const;
+    void print_neighborhood_stats() const;
+    vector<vector<string>> get_connected_components() const;
+    void export_adjacency_matrix(const string& output_path) const;
+    void export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const;
+    void export_all_components_to_single_file(const string& output_file_path) const;
+    void export_all_component_adjacency_matrices_to_single_file(const string& output_file_path) const;
+};
+
+/**************** Աʵ ****************/
+
+StreamingGraph::StreamingGraph(const string& dataPath, const StreamingOptions& options)
+    : dataPath_(dataPath), options_(options) {
+    MatrixInputStream file(dataPath);
+    if (!file) throw runtime_error("޷ļ: " + dataPath);
+
+    MatrixRowReader reader(file, '\t');
+    if (!reader.next_row()) {
+        throw runtime_error("ļΪ");
+    }
+    nodeIds_.assign(reader.tokens().begin(), reader.tokens().end());
+    if (nodeIds_.empty()) {
+        throw runtime_error("ڵIDбΪ");
+    }
+    if (nodeIds_.size() >= UINT32_MAX) {
+        throw runtime_error("ڵַ֧Χ");
+    }
+    if (options_.memory_budget_mb == 0) {
+        throw invalid_argument("ڴޱ 0");
+    }
+
+    const filesystem::path base = options_.temp_dir.empty()
+        ? filesystem::temp_directory_path() : filesystem::path(options_.temp_dir);
+    const auto stamp = chrono::steady_clock::now().time_since_epoch().count();
+    temp_dir_ = (base / ("lspq_stream_" + to_string(stamp) + "_" + to_string(reinterpret_cast<uintptr_t>(this)))).string();
+    filesystem::create_directories(temp_dir_);
+}
+
+StreamingGraph::~StreamingGraph() {
+    edges_.reset();
+    error_code ignored;
+    filesystem::remove_all(temp_dir_, ignored);
+}
+
+// пռԼΪ  * N * (8 ֵֽ + Լ 7 ֽı)ȡڴ޵ķ֮һ
+size_t StreamingGraph::block_rows() const {
+    const size_t row_bytes = nodeIds_.size() * (sizeof(double) + 7) + 64;
+    return min<size_t>(max<size_t>(budget_bytes() / 4 / row_bytes, 1), 4096);
+}
+
+void StreamingGraph::require_analysis() const {
+    if (!analyzed_) throw logic_error("Ҫȵ perform_neighborhood_analysis");
+}
+
+template <typename F>
+void StreamingGraph::for_each_row(F&& f) const {
+    MatrixInputStream file(dataPath_);
+    if (!file) throw runtime_error("޷ļ: " + dataPath_);
+
+    const size_t n = nodeIds_.size();
+    const size_t rows = block_rows();
+    const size_t workers = resolve_thread_count(options_.threads);
+
+    string header;
+    getline(file, header);
+
+    vector<unique_ptr<MatrixRowReader>> readers;
+    for (size_t w = 0; w < workers; ++w) readers.push_back(make_unique<MatrixRowReader>('\t'));
+    vector<string> lines(rows);
+    vector<double> values(rows * n);
+
+    for (size_t first = 0; first < n; first += rows) {
+        const size_t count = min(rows, n - first);
+        for (size_t r = 0; r < count; ++r) {
+            if (!getline(file, lines[r])) {
+                throw runtime_error("ȱٵ" + to_string(first + r + 1) + "");
+            }
+        }
+
+        parallel_for_blocks(count, 1, workers, [&](size_t begin, size_t end, size_t worker) {
+            MatrixRowReader& reader = *readers[worker];
+            for (size_t r = begin; r < end; ++r) {
+                const size_t i = first + r;
+                reader.assign_row(move(lines[r]));
+                if (reader.size() != n + 1) {
+                    throw runtime_error("" + to_string(i + 1) + "ƥ䣬Ԥ: " +
+                        to_string(n + 1) + " ʵ: " + to_string(reader.size()));
+                }
+                if (reader[0] != string_view(nodeIds_[i])) {
+                    throw runtime_error("ڵIDƥ:  " + to_string(i + 1) +
+                        " Ԥ " + nodeIds_[i] + " ʵ " + string(reader[0]));
+                }
+                double* row = &values[r * n];
+                for (size_t j = 1; j <= n; ++j) {
+                    if (j - 1 == i) {
+                        row[i] = 0.0; // Խ Graph һ
+                        continue;
+                    }
+                    if (!MatrixRowReader::to_double(reader[j], row[j - 1])) {
+                        throw runtime_error("" + to_string(i + 1) + "е" +
+                            to_string(j + 1) + "ֵЧ: " + string(reader[j]));
+                    }
+                }
+            }
+        });
+        LSPQ_PROFILE_COUNT("cells_parsed", count * n);
+
+        for (size_t r = 0; r < count; ++r) {
+            f(first + r, &values[r * n]);
+        }
+    }
+}
+
+// Ԫϣĸ޹أ(С±, ϴ±, ֵ)
+uint64_t StreamingGraph::cell_hash(uint64_t a, uint64_t b, double weight) {
+    if (weight == 0.0) weight = 0.0;  // ͳһ -0.0
+    uint64_t bits;
+    memcpy(&bits, &weight, sizeof(bits));
+    uint64_t x = (a << 32) ^ b ^ (bits * 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Գ֤һʽȡȽǵԪϣ֮ͣ
+//  Graph::validate_symmetry  1e-9 ݲͬҪֵȫͬ
+void StreamingGraph::validate_symmetry() const {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::validate_symmetry");
+    uint64_t upper = 0;
+    uint64_t lower = 0;
+    for_each_row([&](size_t i, const double* row) {
+        for (size_t j = 0; j < i; ++j) lower += cell_hash(j, i, row[j]);
+        for (size_t j = i + 1; j < nodeIds_.size(); ++j) upper += cell_hash(i, j, row[j]);
+    });
+    if (upper != lower) {
+        throw runtime_error("ͼԳƻ: ǲһ");
+    }
+    cout << "ͼԳ֤ͨ\n";
+}
+
+void StreamingGraph::print_summary() const {
+    cout << "ͼ\n";
+    cout << "ڵ: " << nodeIds_.size() << endl;
+}
+
+uint32_t StreamingGraph::find_root(vector<uint32_t>& parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// ֧֧ͨС± Graph ڵ˳ DFS ķ֧˳֧ͬڽڵ㰴±
+void StreamingGraph::build_components(vector<uint32_t>& parent) {
+    const size_t n = nodeIds_.size();
+    component_.assign(n, UINT32_MAX);
+    vector<uint32_t> rank_of_root(n, UINT32_MAX);
+    uint32_t components = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint32_t root = find_root(parent, i);
+        if (rank_of_root[root] == UINT32_MAX) rank_of_root[root] = components++;
+        component_[i] = rank_of_root[root];
+    }
+
+    component_offsets_.assign(components + 1, 0);
+    for (uint32_t c : component_) ++component_offsets_[c + 1];
+    for (size_t c = 0; c < components; ++c) component_offsets_[c + 1] += component_offsets_[c];
+    component_nodes_.resize(n);
+    vector<size_t> cursor(component_offsets_.begin(), component_offsets_.end() - 1);
+    for (uint32_t i = 0; i < n; ++i) component_nodes_[cursor[component_[i]]++] = i;
+}
+
+void StreamingGraph::perform_neighborhood_analysis(double small_threshold, double medium_threshold,
+    double large_threshold, size_t min_neighbors) {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::perform_neighborhood_analysis");
+    cout << "ʼ...\n";
+    cout << "ֵ: =" << small_threshold << ", =" << medium_threshold
+        << ", С=" << large_threshold << "\n";
+    cout << "ھԼ: =" << min_neighbors << "\n";
+
+    const size_t n = nodeIds_.size();
+    const double skipped = -numeric_limits<double>::infinity();
+    thresholds_.assign(n, skipped);
+    degree_.assign(n, 0);
+    vector<uint32_t> parent(n);
+    for (uint32_t i = 0; i < n; ++i) parent[i] = i;
+
+    const size_t edge_capacity = budget_bytes() * 3 / 8 / sizeof(EdgeRecord);
+    edges_ = make_unique<ExternalSorter<EdgeRecord, BySource>>(temp_dir_, edge_capacity);
+
+    int nodes_processed = 0;
+    int small_threshold_cuts = 0;
+    int medium_threshold_cuts = 0;
+    int large_threshold_cuts = 0;
+    int skipped_nodes = 0;
+    size_t edges_cut = 0;
+    uint64_t upper = 0;
+    uint64_t lower = 0;
+
+    for_each_row([&](size_t i, const double* row) {
+        // ͳƵ i ڵ㴦ʱԴڵıߣԼеڸֵı
+        size_t live = 0;
+        size_t below_small = 0, below_medium = 0, below_large = 0;
+        auto count = [&](double w) {
+            ++live;
+            below_small += w < small_threshold;
+            below_medium += w < medium_threshold;
+            below_large += w < large_threshold;
+        };
+        for (size_t j = 0; j < i; ++j) {
+            lower += cell_hash(j, i, row[j]);
+            if (row[j] >= thresholds_[j]) count(row[j]);
+        }
+        for (size_t j = i + 1; j < n; ++j) {
+            upper += cell_hash(i, j, row[j]);
+            count(row[j]);
+        }
+
+        double threshold = skipped;
+        size_t cut = 0;
+        if (live <= min_neighbors) {
+            skipped_nodes++;
+        }
+        else if (live - below_small >= min_neighbors) {
+            threshold = small_threshold;
+            cut = below_small;
+            small_threshold_cuts++;
+            nodes_processed++;
+        }
+        else if (live - below_medium >= min_neighbors) {
+            threshold = medium_threshold;
+            cut = below_medium;
+            medium_threshold_cuts++;
+            nodes_processed++;
+        }
+        else {
+            threshold = large_threshold;
+            cut = below_large;
+            large_threshold_cuts++;
+            nodes_processed++;
+        }
+        thresholds_[i] = threshold;
+        edges_cut += cut;
+
+        // ǰڵ֮ıߴʱж
+        for (uint32_t j = 0; j < i; ++j) {
+            const double w = row[j];
+            if (w < thresholds_[j] || w < threshold) continue;
+            const uint32_t u = static_cast<uint32_t>(i);
+            edges_->push({ u, j, w });
+            edges_->push({ j, u, w });
+            ++degree_[i];
+            ++degree_[j];
+            const uint32_t a = find_root(parent, u);
+            const uint32_t b = find_root(parent, j);
+            if (a != b) parent[max(a, b)] = min(a, b);
+        }
+    });
+
+    if (upper != lower) {
+        throw runtime_error("ͼԳƻ: ǲһ");
+    }
+
+    edges_->finish();
+    build_components(parent);
+    analyzed_ = true;
+    LSPQ_PROFILE_COUNT("edges_cut", edges_cut);
+    LSPQ_PROFILE_COUNT("edges_inserted", edges_->size());
+
+    cout << ":\n";
+    cout << "ڵ: " << nodes_processed << "\n";
+    cout << "ڵ: " << skipped_nodes << "\n";
+    cout << "Сֵи: " << small_threshold_cuts << "\n";
+    cout << "ֵи: " << medium_threshold_cuts << "\n";
+    cout << "ֵи: " << large_threshold_cuts << "\n";
+    cout << ": " << edge_count() << "д: " << spilled_runs() << "\n";
+
+    int components = count_connected_components();
+    cout << "֧ͨ: " << components << "\n";
+}
+
+int StreamingGraph::count_connected_components() const {
+    require_analysis();
+    return static_cast<int>(component_offsets_.size() - 1);
+}
+
+void StreamingGraph::print_neighborhood_stats() const {
+    require_analysis();
+    size_t min_neighbors = SIZE_MAX;
+    size_t max_neighbors = 0;
+    double avg_neighbors = 0.0;
+    for (uint32_t d : degree_) {
+        min_neighbors = min<size_t>(min_neighbors, d);
+        max_neighbors = max<size_t>(max_neighbors, d);
+        avg_neighbors += d;
+    }
+    avg_neighbors /= nodeIds_.size();
+
+    cout << "ھͳϢ:\n";
+    cout << "Сھ: " << min_neighbors << "\n";
+    cout << "ھ: " << max_neighbors << "\n";
+    cout << "ƽھ: " << avg_neighbors << "\n";
+}
+
+vector<vector<string>> StreamingGraph::get_connected_components() const {
+    require_analysis();
+    vector<vector<string>> all_components;
+    for (size_t c = 0; c + 1 < component_offsets_.size(); ++c) {
+        vector<string> names;
+        names.reserve(component_offsets_[c + 1] - component_offsets_[c]);
+        for (size_t k = component_offsets_[c]; k < component_offsets_[c + 1]; ++k) {
+            names.push_back(nodeIds_[component_nodes_[k]]);
+        }
+        all_components.push_back(move(names));
+    }
+    return all_components;
+}
+
+// Դڵ˳鲢ߣд
+void StreamingGraph::export_adjacency_matrix(const string& output_path) const {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::export_adjacency_matrix");
+    require_analysis();
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    const size_t n = nodeIds_.size();
+    outfile << "\t";
+    for (size_t i = 0; i < n; ++i) {
+        outfile << nodeIds_[i] << (i == n - 1 ? "" : "\t");
+    }
+    outfile << "\n";
+
+    edges_->rewind();
+    EdgeRecord edge;
+    bool has_edge = edges_->next(edge);
+    string row(2 * n, '\t');
+    for (uint32_t u = 0; u < n; ++u) {
+        for (size_t i = 0; i < n; ++i) row[2 * i] = '0';
+        row[2 * u] = '-';
+        for (; has_edge && edge.source == u; has_edge = edges_->next(edge)) row[2 * edge.target] = '1';
+        row[2 * n - 1] = '\n';
+        outfile << nodeIds_[u] << "\t";
+        outfile.write(row.data(), row.size());
+    }
+
+    outfile.close();
+    cout << "ڽӾѵ: " << output_path << endl;
+}
+
+void StreamingGraph::export_edge_list_for_cytoscape(const string& output_path, const string& interaction_type) const {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::export_edge_list_for_cytoscape");
+    require_analysis();
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "SourceNode\tTargetNode\tInteractionType\tWeight\n";
+
+    edges_->rewind();
+    EdgeRecord edge;
+    while (edges_->next(edge)) {
+        const string& source_node = nodeIds_[edge.source];
+        const string& target_node = nodeIds_[edge.target];
+        if (source_node < target_node) {
+            outfile << source_node << "\t"
+                << target_node << "\t"
+                << interaction_type << "\t"
+                << edge.weight << "\n";
+        }
+    }
+
+    outfile.close();
+    cout << "Cytoscape б (Ȩ) ѵ: " << output_path << endl;
+}
+
+void StreamingGraph::export_all_components_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::export_all_components_to_single_file");
+    require_analysis();
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    const size_t components = component_offsets_.size() - 1;
+    cout << " " << components << " ֧ͨڵļ: " << output_file_path << endl;
+
+    for (size_t c = 0; c < components; ++c) {
+        outfile << "Component " << (c + 1) << " (Nodes: " << component_offsets_[c + 1] - component_offsets_[c] << "):\n";
+        for (size_t k = component_offsets_[c]; k < component_offsets_[c + 1]; ++k) {
+            outfile << nodeIds_[component_nodes_[k]] << "\n";
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "֧ͨѵ: " << output_file_path << endl;
+}
+
+// ȰѴ߰ (֧, Դ, Ŀ) һ֧֮γ
+void StreamingGraph::export_all_component_adjacency_matrices_to_single_file(const string& output_file_path) const {
+    LSPQ_PROFILE_SCOPE("StreamingGraph::export_all_component_adjacency_matrices_to_single_file");
+    require_analysis();
+    AsyncFileWriter outfile(output_file_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_file_path);
+    }
+
+    const size_t components = component_offsets_.size() - 1;
+    cout << " " << components << " ֧ͨڵڽӾ: " << output_file_path << endl;
+
+    ExternalSorter<EdgeRecord, ByComponent> by_component(temp_dir_,
+        budget_bytes() * 3 / 8 / sizeof(EdgeRecord), ByComponent{ &component_ });
+    edges_->rewind();
+    EdgeRecord edge;
+    while (edges_->next(edge)) by_component.push(edge);
+    by_component.finish();
+
+    bool has_edge = by_component.next(edge);
+    vector<uint32_t> local(nodeIds_.size(), UINT32_MAX);
+    string row;
+    for (size_t c = 0; c < components; ++c) {
+        const uint32_t* component_nodes = &component_nodes_[component_offsets_[c]];
+        const size_t k = component_offsets_[c + 1] - component_offsets_[c];
+        for (size_t j = 0; j < k; ++j) local[component_nodes[j]] = static_cast<uint32_t>(j);
+
+        outfile << "Component " << (c + 1) << " Adjacency Matrix (Nodes: " << k << "):\n";
+
+        outfile << "\t";
+        for (size_t j = 0; j < k; ++j) {
+            outfile << nodeIds_[component_nodes[j]] << (j == k - 1 ? "" : "\t");
+        }
+        outfile << "\n";
+
+        row.assign(2 * k, '\t');
+        for (size_t r = 0; r < k; ++r) {
+            const uint32_t u = component_nodes[r];
+            for (size_t j = 0; j < k; ++j) row[2 * j] = '0';
+            row[2 * r] = '-';
+            for (; has_edge && edge.source == u; has_edge = by_component.next(edge)) row[2 * local[edge.target]] = '1';
+            row[2 * k - 1] = '\n';
+            outfile << nodeIds_[u] << "\t";
+            outfile.write(row.data(), row.size());
+        }
+        outfile << "\n";
+
+        for (size_t j = 0; j < k; ++j) local[component_nodes[j]] = UINT32_MAX;
+    }
+
+    outfile.close();
+    cout << "֧ͨڽӾѵ: " << output_file_path << endl;
+}
+
+#endif // LSPQ_STREAMING_GRAPH_HPP
@@ -0,0 +1,193 @@
+/**
+ ********************************************
+ * @file    :SyntheticMatrix.hpp
+ * @author  :XXY
+ * @brief   :Reproducible synthetic percent-identity matrices
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_SYNTHETIC_MATRIX_HPP
+#define LSPQ_SYNTHETIC_MATRIX_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+// ϳɾƶȣٷֱȣֲ̬ɲضϵ [0, 100)λС
+struct SyntheticMatrixOptions {
+    size_t nodes = 1000;
+    size_t clusters = 20;
+    double singleton_fraction = 0.05;  // κδصĹб
+    double intra_mean = 85.0;          // ƶȷֲ
+    double intra_stddev = 6.0;
+    double inter_mean = 35.0;          // ؼ䣨ԼУƶȷֲ
+    double inter_stddev = 5.0;
+    uint64_t seed = 42;
+};
+
+//  output_pim2.txt ͬʽƱָ
+// ÿԪֻ (seed, i, j) Ĺϣ˳ƽ̨ͱ׼ʵ޹أ
+// ȻԳƣдļʱɣҪڴб N*N ľ
+class SyntheticMatrix {
+    SyntheticMatrixOptions options_;
+    vector<uint32_t> cluster_of_;  // еĴغΪ kSingleton
+
+    static uint64_t mix(uint64_t x);
+    uint64_t hash(uint64_t a, uint64_t b, uint64_t salt) const;
+    static double to_unit(uint64_t h) { return (h >> 11) * (1.0 / 9007199254740992.0); }
+    static char* append_centi(char* out, uint32_t centi);
+
+public:
+    static constexpr uint32_t kSingleton = UINT32_MAX;
+
+    explicit SyntheticMatrix(const SyntheticMatrixOptions& options);
+
+    const SyntheticMatrixOptions& options() const { return options_; }
+    size_t node_count() const { return cluster_of_.size(); }
+    uint32_t cluster_of(size_t i) const { return cluster_of_[i]; }
+    string node_id(size_t i) const;
+
+    // ƶȣλΪ 0.01%ԽΪ 10000
+    uint32_t identity_centi(size_t i, size_t j) const;
+    double identity(size_t i, size_t j) const { return identity_centi(i, j) / 100.0; }
+
+    // д󣬷дֽ
+    size_t write(const string& output_path) const;
+    // дʵĴػ֣ÿУڵID\tغţΪ -1
+    void write_truth(const string& output_path) const;
+};
+
+/**************** Աʵ ****************/
+
+SyntheticMatrix::SyntheticMatrix(const SyntheticMatrixOptions& options)
+    : options_(options), cluster_of_(options.nodes) {
+    if (options.nodes == 0) throw invalid_argument("ڵ 0");
+    if (options.clusters == 0) throw invalid_argument(" 0");
+    if (options.singleton_fraction < 0.0 || options.singleton_fraction > 1.0) {
+        throw invalid_argument("б [0, 1] ֮");
+    }
+
+    for (size_t i = 0; i < options.nodes; ++i) {
+        if (to_unit(hash(i, 0, 1)) < options.singleton_fraction) {
+            cluster_of_[i] = kSingleton;
+        }
+        else {
+            cluster_of_[i] = static_cast<uint32_t>(hash(i, 0, 2) % options.clusters);
+        }
+    }
+}
+
+// splitmix64 սắ
+uint64_t SyntheticMatrix::mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t SyntheticMatrix::hash(uint64_t a, uint64_t b, uint64_t salt) const {
+    return mix(mix(mix(options_.seed ^ (salt << 56)) ^ a) ^ b);
+}
+
+string SyntheticMatrix::node_id(size_t i) const {
+    string id = to_string(i);
+    return "SYN" + string(id.size() < 7 ? 7 - id.size() : 0, '0') + id;
+}
+
+uint32_t SyntheticMatrix::identity_centi(size_t i, size_t j) const {
+    if (i == j) return 10000;
+    const size_t a = min(i, j);
+    const size_t b = max(i, j);
+    const bool same = cluster_of_[a] != kSingleton && cluster_of_[a] == cluster_of_[b];
+    const double mean = same ? options_.intra_mean : options_.inter_mean;
+    const double stddev = same ? options_.intra_stddev : options_.inter_stddev;
+
+    // Box-Mullerȷֲõһ׼̬
+    const double u1 = max(to_unit(hash(a, b, 3)), 1e-300);
+    const double u2 = to_unit(hash(a, b, 4));
+    const double z = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+    const double value = min(max(mean + stddev * z, 0.0), 99.99);
+    return static_cast<uint32_t>(llround(value * 100.0));
+}
+
+// ʽдλС8500 -> "85"8550 -> "85.5"8555 -> "85.55"
+char* SyntheticMatrix::append_centi(char* out, uint32_t centi) {
+    uint32_t whole = centi / 100;
+    const uint32_t frac = centi % 100;
+    char digits[4];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole);
+    while (n) *out++ = digits[--n];
+    if (frac) {
+        *out++ = '.';
+        *out++ = static_cast<char>('0' + frac / 10);
+        if (frac % 10) *out++ = static_cast<char>('0' + frac % 10);
+    }
+    return out;
+}
+
+size_t SyntheticMatrix::write(const string& output_path) const {
+    ofstream outfile(output_path, ios::binary);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    const size_t n = node_count();
+    vector<string> ids(n);
+    for (size_t i = 0; i < n; ++i) ids[i] = node_id(i);
+
+    size_t bytes = 0;
+    string line;
+    for (size_t i = 0; i < n; ++i) {
+        line += '\t';
+        line += ids[i];
+    }
+    line += '\n';
+    outfile.write(line.data(), line.size());
+    bytes += line.size();
+
+    // ÿֵ 6 ַ"100"  "99.99"һָ
+    vector<char> row(ids.back().size() + n * 7 + 2);
+    for (size_t i = 0; i < n; ++i) {
+        char* p = row.data();
+        p = copy(ids[i].begin(), ids[i].end(), p);
+        for (size_t j = 0; j < n; ++j) {
+            *p++ = '\t';
+            p = append_centi(p, identity_centi(i, j));
+        }
+        *p++ = '\n';
+        const size_t length = p - row.data();
+        outfile.write(row.data(), length);
+        bytes += length;
+    }
+
+    outfile.close();
+    if (!outfile) throw runtime_error("дļʧ: " + output_path);
+    return bytes;
+}
+
+void SyntheticMatrix::write_truth(const string& output_path) const {
+    ofstream outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+    for (size_t i = 0; i < node_count(); ++i) {
+        outfile << node_id(i) << "\t";
+        if (cluster_of_[i] == kSingleton) outfile << -1;
+        else outfile << cluster_of_[i];
+        outfile << "\n";
+    }
+}
+
+#endif // LSPQ_SYNTHETIC_MATRIX_HPP
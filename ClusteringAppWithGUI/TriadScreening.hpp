@@ -0,0 +1,562 @@
+/**
+ ********************************************
+ * @file    :TriadScreening.hpp
+ * @author  :XXY
+ * @brief   :Parallel Ser-His-Asp catalytic triad screening against a reference profile
+ * @date    :2026/10/18
+ ********************************************
+ */
+
+#ifndef LSPQ_TRIAD_SCREENING_HPP
+#define LSPQ_TRIAD_SCREENING_HPP
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cctype>
+
+#include "Representatives.hpp"
+#include "Parallel.hpp"
+#include "Profiler.hpp"
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+struct TriadScreeningOptions {
+    int gap_open = 11;    // ¿һλĶ֣ⷣBLOSUM62 ֵ
+    int gap_extend = 1;   // λÿӳһлķ
+    size_t threads = 0;   // 0 ʾȫӲ߳
+};
+
+struct FastaRecord {
+    string id;        // еһհ֮ǰĲ֣ Biopython  record.id ͬ
+    string sequence;  // дȥհ׺ͱȶõ '-''.'
+};
+
+// ȡ FASTA ļļûκμ¼ʱ׳쳣
+inline vector<FastaRecord> read_fasta(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        throw runtime_error("޷ FASTA ļ: " + path);
+    }
+    vector<FastaRecord> records;
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line[0] == '>') {
+            const size_t end = line.find_first_of(" \t", 1);
+            records.push_back({ line.substr(1, end == string::npos ? string::npos : end - 1), string() });
+            continue;
+        }
+        if (records.empty()) {
+            throw runtime_error("FASTA ʽгڵһ֮ǰ: " + path);
+        }
+        for (char ch : line) {
+            if (!isspace(static_cast<unsigned char>(ch)) && ch != '-' && ch != '.') {
+                records.back().sequence.push_back(static_cast<char>(toupper(static_cast<unsigned char>(ch))));
+            }
+        }
+    }
+    if (records.empty()) {
+        throw runtime_error("FASTA ļû: " + path);
+    }
+    return records;
+}
+
+// ˿ˮø߻壨Ser-His-Aspɸ顣
+// ԭűÿδ֪жȫ֪һһ MAFFT бȶԣN ѡ N ȶԡ
+// ֻڹʱ֪οȶһΣ
+//   1.  3-mer ƶ֮ѡУοиһȫֱȶԣGotoh λBLOSUM62
+//      ٰкϲΪοбȶԣcenter-star
+//   2. ڲοȶһȷʶ S/H/D УÿֲлȡִУͬȡǰߣ
+//   3. οȶתΪףÿилƵʣÿδ֪һαȶԣ֮䲢С
+// ױȶԵƥΪилƵʼȨ BLOSUM62 ֵһеĿλְеķǿλţ
+// ˲οֻоеĲױ˿λ֣Ƭв򳤶Ȳͬ
+// ԭűĲ𣺹ʶֻɲοоδ֪вбк˶ͬ
+class TriadScreener {
+public:
+    struct Hit {
+        size_t sequence = 0;        // δ֪е±
+        long long component = 0;    // ֧ͨţ 1 ʼ0 ʾκη֧
+        int residue[3] = { -1, -1, -1 };  // ʶ S/H/D ϵĲлδ֪е±꣬-1 ʾλ
+        bool conserved = false;
+        string aligned;             // οȶеδ֪УдΪл'-' ΪλСдΪ
+    };
+
+private:
+    static constexpr int kAlphabet = 24;  // ARNDCQEGHILKMFPSTWYVBZX*
+
+    TriadScreeningOptions options_;
+    vector<FastaRecord> known_;
+    vector<string> reference_;            // οбȶԣÿгͬ
+    vector<float> profile_score_;         //   л ƥ
+    vector<float> occupancy_;             // ÿеķǿλ
+    size_t consensus_[3] = { 0, 0, 0 };   // ʶ S/H/D 
+    size_t consensus_count_[3] = { 0, 0, 0 };
+
+    vector<FastaRecord> unknown_;
+    unordered_map<string, long long> component_of_;
+    vector<size_t> selected_;             // Ҫɸδ֪±꣬ FASTA е˳
+    vector<Hit> hits_;
+
+    // ˽й߷
+    static int residue_index(char ch);
+    static int blosum62(int a, int b);
+    static vector<uint8_t> encode(const string& sequence);
+    void build_reference();
+    void build_profile(const vector<string>& rows, vector<float>& score, vector<float>& occupancy) const;
+    // ׵ıȶ·'M' л룬'D' һУ'I' лӦκ
+    string align(const vector<float>& score, const vector<float>& occupancy, const vector<uint8_t>& sequence) const;
+
+public:
+    // ֪οУɲοȶԲȷʶ
+    TriadScreener(const string& known_fasta, const TriadScreeningOptions& options = TriadScreeningOptions());
+
+    void load_unknowns(const string& unknown_fasta);
+    // þע֧ţ˳ all_components.txt ͬ
+    void set_components(const vector<vector<string>>& components);
+    template <typename G>
+    void set_components_from(const G& graph) { set_components(graph.get_connected_components()); }
+    // ֻɸ ID 
+    void restrict_to(const vector<string>& ids);
+    // ÿֻ֧ͨɸһͬʱע֧
+    void restrict_to_representatives(const RepresentativeSelector& selector,
+        RepresentativeKind kind = RepresentativeKind::Medoid);
+
+    void run();
+    const vector<Hit>& hits() const { return hits_; }
+    const vector<string>& reference_alignment() const { return reference_; }
+
+    // ԭűͬǰУӷ֧źлδ֪еλã 1 ʼ
+    void export_summary(const string& output_path) const;
+    // οȶԼδ֪аοеıȶԽa2m 
+    void export_alignments(const string& output_path) const;
+};
+
+/**************** Աʵ ****************/
+
+int TriadScreener::residue_index(char ch) {
+    static const string order = "ARNDCQEGHILKMFPSTWYVBZX*";
+    const size_t pos = order.find(ch);
+    return pos == string::npos ? 22 : static_cast<int>(pos);  // ĸUOJ ȣ X 
+}
+
+int TriadScreener::blosum62(int a, int b) {
+    static const int8_t matrix[kAlphabet][kAlphabet] = {
+        {  4, -1, -2, -2,  0, -1, -1,  0, -2, -1, -1, -1, -1, -2, -1,  1,  0, -3, -2,  0, -2, -1,  0, -4 },
+        { -1,  5,  0, -2, -3,  1,  0, -2,  0, -3, -2,  2, -1, -3, -2, -1, -1, -3, -2, -3, -1,  0, -1, -4 },
+        { -2,  0,  6,  1, -3,  0,  0,  0,  1, -3, -3,  0, -2, -3, -2,  1,  0, -4, -2, -3,  3,  0, -1, -4 },
+        { -2, -2,  1,  6, -3,  0,  2, -1, -1, -3, -4, -1, -3, -3, -1,  0, -1, -4, -3, -3,  4,  1, -1, -4 },
+        {  0, -3, -3, -3,  9, -3, -4, -3, -3, -1, -1, -3, -1, -2, -3, -1, -1, -2, -2, -1, -3, -3, -2, -4 },
+        { -1,  1,  0,  0, -3,  5,  2, -2,  0, -3, -2,  1,  0, -3, -1,  0, -1, -2, -1, -2,  0,  3, -1, -4 },
+        { -1,  0,  0,  2, -4,  2,  5, -2,  0, -3, -3,  1, -2, -3, -1,  0, -1, -3, -2, -2,  1,  4, -1, -4 },
+        {  0, -2,  0, -1, -3, -2, -2,  6, -2, -4, -4, -2, -3, -3, -2,  0, -2, -2, -3, -3, -1, -2, -1, -4 },
+        { -2,  0,  1, -1, -3,  0,  0, -2,  8, -3, -3, -1, -2, -1, -2, -1, -2, -2,  2, -3,  0,  0, -1, -4 },
+        { -1, -3, -3, -3, -1, -3, -3, -4, -3,  4,  2, -3,  1,  0, -3, -2, -1, -3, -1,  3, -3, -3, -1, -4 },
+        { -1, -2, -3, -4, -1, -2, -3, -4, -3,  2,  4, -2,  2,  0, -3, -2, -1, -2, -1,  1, -4, -3, -1, -4 },
+        { -1,  2,  0, -1, -3,  1,  1, -2, -1, -3, -2,  5, -1, -3, -1,  0, -1, -3, -2, -2,  0,  1, -1, -4 },
+        { -1, -1, -2, -3, -1,  0, -2, -3, -2,  1,  2, -1,  5,  0, -2, -1, -1, -1, -1,  1, -3, -1, -1, -4 },
+        { -2, -3, -3, -3, -2, -3, -3, -3, -1,  0,  0, -3,  0,  6, -4, -2, -2,  1,  3, -1, -3, -3, -1, -4 },
+        { -1, -2, -2, -1, -3, -1, -1, -2, -2, -3, -3, -1, -2, -4,  7, -1, -1, -4, -3, -2, -2, -1, -2, -4 },
+        {  1, -1,  1,  0, -1,  0,  0,  0, -1, -2, -2,  0, -1, -2, -1,  4,  1, -3, -2, -2,  0,  0,  0, -4 },
+        {  0, -1,  0, -1, -1, -1, -1, -2, -2, -1, -1, -1, -1, -2, -1,  1,  5, -2, -2,  0, -1, -1,  0, -4 },
+        { -3, -3, -4, -4, -2, -2, -3, -2, -2, -3, -2, -3, -1,  1, -4, -3, -2, 11,  2, -3, -4, -3, -2, -4 },
+        { -2, -2, -2, -3, -2, -1, -2, -3,  2, -1, -1, -2, -1,  3, -3, -2, -2,  2,  7, -1, -3, -2, -1, -4 },
+        {  0, -3, -3, -3, -1, -2, -2, -3, -3,  3,  1, -2,  1, -1, -2, -2,  0, -3, -1,  4, -3, -2, -1, -4 },
+        { -2, -1,  3,  4, -3,  0,  1, -1,  0, -3, -4,  0, -3, -3, -2,  0, -1, -4, -3, -3,  4,  1, -1, -4 },
+        { -1,  0,  0,  1, -3,  3,  4, -2,  0, -3, -3,  1, -1, -3, -1,  0, -1, -3, -2, -2,  1,  4, -1, -4 },
+        {  0, -1, -1, -1, -2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -2,  0,  0, -2, -1, -1, -1, -1, -1, -4 },
+        { -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4,  1 },
+    };
+    return matrix[a][b];
+}
+
+vector<uint8_t> TriadScreener::encode(const string& sequence) {
+    vector<uint8_t> codes(sequence.size());
+    for (size_t i = 0; i < sequence.size(); ++i) codes[i] = static_cast<uint8_t>(residue_index(sequence[i]));
+    return codes;
+}
+
+TriadScreener::TriadScreener(const string& known_fasta, const TriadScreeningOptions& options)
+    : options_(options), known_(read_fasta(known_fasta)) {
+    for (const auto& record : known_) {
+        if (record.sequence.empty()) throw runtime_error("οΪ: " + record.id);
+    }
+    build_reference();
+}
+
+void TriadScreener::build_profile(const vector<string>& rows, vector<float>& score, vector<float>& occupancy) const {
+    const size_t columns = rows.front().size();
+    score.assign(columns * kAlphabet, 0.0f);
+    occupancy.assign(columns, 0.0f);
+    const float weight = 1.0f / static_cast<float>(rows.size());
+    for (size_t c = 0; c < columns; ++c) {
+        float* column = &score[c * kAlphabet];
+        for (const string& row : rows) {
+            if (row[c] == '-') continue;
+            const int a = residue_index(row[c]);
+            occupancy[c] += weight;
+            for (int b = 0; b < kAlphabet; ++b) column[b] += weight * blosum62(a, b);
+        }
+    }
+}
+
+// Gotoh ״̬̬滮й棬ݷÿ 1 ֽڣM/D/I ռ 2 λ
+// ˿λ֣ 0 С 0 Ϊ 0յȡһлһϵֵ
+string TriadScreener::align(const vector<float>& score, const vector<float>& occupancy,
+    const vector<uint8_t>& sequence) const {
+    enum : uint8_t { kMatch = 0, kDelete = 1, kInsert = 2 };
+    const float kNone = -1e30f;
+    const size_t columns = occupancy.size();
+    const size_t length = sequence.size();
+    const size_t width = length + 1;
+    const float open = static_cast<float>(options_.gap_open + options_.gap_extend);
+    const float extend = static_cast<float>(options_.gap_extend);
+
+    vector<uint8_t> trace((columns + 1) * width, 0);
+    vector<float> m(width, kNone), d(width, kNone), ins(width, 0.0f);
+    vector<float> pm(width), pd(width), pins(width);
+    m[0] = 0.0f;
+    ins[0] = kNone;
+
+    // յѡһУʣлΪ룩һУʣΪλ
+    float best = kNone;
+    size_t best_i = 0, best_j = 0;
+    uint8_t best_state = kMatch;
+    auto consider = [&](size_t i, size_t j) {
+        const float values[3] = { m[j], d[j], ins[j] };
+        for (uint8_t s = 0; s < 3; ++s) {
+            if (values[s] > best) {
+                best = values[s];
+                best_i = i;
+                best_j = j;
+                best_state = s;
+            }
+        }
+    };
+    if (columns == 0) {
+        for (size_t j = 0; j <= length; ++j) consider(0, j);
+    }
+
+    for (size_t i = 1; i <= columns; ++i) {
+        swap(m, pm);
+        swap(d, pd);
+        swap(ins, pins);
+        const float* column = &score[(i - 1) * kAlphabet];
+        const float column_open = occupancy[i - 1] * open;
+        const float column_extend = occupancy[i - 1] * extend;
+        uint8_t* row_trace = &trace[i * width];
+
+        m[0] = kNone;
+        d[0] = 0.0f;
+        ins[0] = kNone;
+        for (size_t j = 1; j <= length; ++j) {
+            uint8_t t = 0;
+
+            float v = pm[j - 1];
+            uint8_t from = kMatch;
+            if (pd[j - 1] > v) { v = pd[j - 1]; from = kDelete; }
+            if (pins[j - 1] > v) { v = pins[j - 1]; from = kInsert; }
+            m[j] = v + column[sequence[j - 1]];
+            t |= from;
+
+            v = pm[j] - column_open;
+            from = kMatch;
+            if (pd[j] - column_extend > v) { v = pd[j] - column_extend; from = kDelete; }
+            if (pins[j] - column_open > v) { v = pins[j] - column_open; from = kInsert; }
+            d[j] = v;
+            t |= from << 2;
+
+            v = m[j - 1] - open;
+            from = kMatch;
+            if (d[j - 1] - open > v) { v = d[j - 1] - open; from = kDelete; }
+            if (ins[j - 1] - extend > v) { v = ins[j - 1] - extend; from = kInsert; }
+            ins[j] = v;
+            t |= from << 4;
+
+            row_trace[j] = t;
+        }
+        consider(i, length);
+        if (i == columns) {
+            for (size_t j = 0; j < length; ++j) consider(i, j);
+        }
+    }
+
+    string path;
+    path.reserve(columns + length);
+    if (best_i == columns) path.append(length - best_j, 'I');
+    else path.append(columns - best_i, 'D');
+    size_t i = best_i, j = best_j;
+    uint8_t state = best_state;
+    while (i > 0 && j > 0) {
+        const uint8_t t = trace[i * width + j];
+        if (state == kMatch) {
+            path.push_back('M');
+            state = t & 3;
+            --i;
+            --j;
+        }
+        else if (state == kDelete) {
+            path.push_back('D');
+            state = (t >> 2) & 3;
+            --i;
+        }
+        else {
+            path.push_back('I');
+            state = (t >> 4) & 3;
+            --j;
+        }
+    }
+    path.append(i, 'D');
+    path.append(j, 'I');
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+void TriadScreener::build_reference() {
+    LSPQ_PROFILE_SCOPE("TriadScreener::build_reference");
+    const size_t count = known_.size();
+    cout << "ʼȶ " << count << " ο...\n";
+
+    // 1. Уй 3-mer ϶гȹһ֮
+    vector<vector<uint32_t>> kmers(count);
+    for (size_t k = 0; k < count; ++k) {
+        const vector<uint8_t> codes = encode(known_[k].sequence);
+        for (size_t p = 0; p + 3 <= codes.size(); ++p) {
+            kmers[k].push_back((codes[p] * kAlphabet + codes[p + 1]) * kAlphabet + codes[p + 2]);
+        }
+        sort(kmers[k].begin(), kmers[k].end());
+    }
+    vector<double> similarity(count, 0.0);
+    parallel_for_blocks(count, 1, options_.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t a = begin; a < end; ++a) {
+            for (size_t b = 0; b < count; ++b) {
+                if (a == b) continue;
+                size_t shared = 0;
+                auto x = kmers[a].begin(), y = kmers[b].begin();
+                while (x != kmers[a].end() && y != kmers[b].end()) {
+                    if (*x < *y) ++x;
+                    else if (*y < *x) ++y;
+                    else { ++shared; ++x; ++y; }
+                }
+                const size_t shorter = min(kmers[a].size(), kmers[b].size());
+                if (shorter > 0) similarity[a] += static_cast<double>(shared) / shorter;
+            }
+        }
+    });
+    const size_t center = static_cast<size_t>(max_element(similarity.begin(), similarity.end()) - similarity.begin());
+    const string& center_sequence = known_[center].sequence;
+    const size_t center_length = center_sequence.size();
+
+    // 2. ибȶԣΪֻһеף
+    vector<float> center_score, center_occupancy;
+    build_profile({ center_sequence }, center_score, center_occupancy);
+    vector<string> paths(count);
+    parallel_for_blocks(count, 1, options_.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t k = begin; k < end; ++k) {
+            if (k == center) paths[k].assign(center_length, 'M');
+            else paths[k] = align(center_score, center_occupancy, encode(known_[k].sequence));
+        }
+    });
+
+    // 3. ϲе i л֮ǰڸôֵ
+    vector<size_t> slot(center_length + 1, 0);
+    for (const string& path : paths) {
+        size_t i = 0, run = 0;
+        for (char op : path) {
+            if (op == 'I') { ++run; continue; }
+            slot[i] = max(slot[i], run);
+            run = 0;
+            ++i;
+        }
+        slot[i] = max(slot[i], run);
+    }
+    size_t columns = center_length;
+    for (size_t s : slot) columns += s;
+
+    reference_.assign(count, string());
+    for (size_t k = 0; k < count; ++k) {
+        string& row = reference_[k];
+        row.reserve(columns);
+        const string& sequence = known_[k].sequence;
+        size_t i = 0, j = 0, run = 0;
+        for (char op : paths[k]) {
+            if (op == 'I') {
+                row.push_back(sequence[j++]);
+                ++run;
+                continue;
+            }
+            row.append(slot[i] - run, '-');
+            run = 0;
+            row.push_back(op == 'M' ? sequence[j++] : '-');
+            ++i;
+        }
+        row.append(slot[i] - run, '-');
+    }
+
+    // 4. ʶο
+    static const char triad[3] = { 'S', 'H', 'D' };
+    static const char* const names[3] = { "Ser", "His", "Asp" };
+    for (int r = 0; r < 3; ++r) {
+        vector<size_t> counts(columns, 0);
+        for (const string& row : reference_) {
+            for (size_t c = 0; c < columns; ++c) {
+                if (row[c] == triad[r]) ++counts[c];
+            }
+        }
+        const auto top = max_element(counts.begin(), counts.end());
+        if (top == counts.end() || *top == 0) {
+            throw runtime_error(string("οû ") + triad[r] + " л޷ȷ߻干ʶ");
+        }
+        consensus_[r] = static_cast<size_t>(top - counts.begin());
+        consensus_count_[r] = *top;
+    }
+    build_profile(reference_, profile_score_, occupancy_);
+
+    cout << "οȶɣ " << known_[center].id << " " << columns << " \n";
+    for (int r = 0; r < 3; ++r) {
+        cout << "  ʶ " << names[r] << " : " << consensus_[r] << "" << consensus_count_[r] << "/" << count
+            << " οУ\n";
+    }
+}
+
+void TriadScreener::load_unknowns(const string& unknown_fasta) {
+    unknown_ = read_fasta(unknown_fasta);
+    selected_.resize(unknown_.size());
+    for (size_t i = 0; i < unknown_.size(); ++i) selected_[i] = i;
+    hits_.clear();
+    cout << "Ѷ " << unknown_.size() << " ɸ\n";
+}
+
+void TriadScreener::set_components(const vector<vector<string>>& components) {
+    for (size_t c = 0; c < components.size(); ++c) {
+        for (const string& name : components[c]) component_of_[name] = static_cast<long long>(c + 1);
+    }
+}
+
+void TriadScreener::restrict_to(const vector<string>& ids) {
+    const unordered_set<string> wanted(ids.begin(), ids.end());
+    selected_.clear();
+    for (size_t i = 0; i < unknown_.size(); ++i) {
+        if (wanted.count(unknown_[i].id)) selected_.push_back(i);
+    }
+    if (selected_.size() < wanted.size()) {
+        cout << ": " << wanted.size() - selected_.size() << " ָ ID ڴɸв\n";
+    }
+}
+
+void TriadScreener::restrict_to_representatives(const RepresentativeSelector& selector, RepresentativeKind kind) {
+    const vector<Representative>& representatives = selector.representatives();
+    vector<string> ids;
+    ids.reserve(representatives.size());
+    for (size_t c = 0; c < representatives.size(); ++c) {
+        const Representative& r = representatives[c];
+        const uint32_t local = kind == RepresentativeKind::Medoid ? r.medoid
+            : kind == RepresentativeKind::MaxDegree ? r.max_degree : r.centroid;
+        ids.push_back(selector.name(c, local));
+        component_of_[ids.back()] = static_cast<long long>(c + 1);
+    }
+    restrict_to(ids);
+}
+
+void TriadScreener::run() {
+    LSPQ_PROFILE_SCOPE("TriadScreener::run");
+    cout << "ʼɸ " << selected_.size() << " еĴ߻...\n";
+    hits_.assign(selected_.size(), Hit());
+
+    static const char triad[3] = { 'S', 'H', 'D' };
+    const size_t columns = occupancy_.size();
+    parallel_for_blocks(selected_.size(), 1, options_.threads, [&](size_t begin, size_t end, size_t) {
+        for (size_t n = begin; n < end; ++n) {
+            Hit& hit = hits_[n];
+            hit.sequence = selected_[n];
+            const string& sequence = unknown_[hit.sequence].sequence;
+            const string path = align(profile_score_, occupancy_, encode(sequence));
+
+            // ο -> δ֪±
+            vector<int> residue_at(columns, -1);
+            size_t i = 0, j = 0;
+            hit.aligned.reserve(path.size());
+            for (char op : path) {
+                if (op == 'M') {
+                    residue_at[i++] = static_cast<int>(j);
+                    hit.aligned.push_back(sequence[j++]);
+                }
+                else if (op == 'D') {
+                    ++i;
+                    hit.aligned.push_back('-');
+                }
+                else {
+                    hit.aligned.push_back(static_cast<char>(tolower(static_cast<unsigned char>(sequence[j++]))));
+                }
+            }
+
+            hit.conserved = true;
+            for (int r = 0; r < 3; ++r) {
+                hit.residue[r] = residue_at[consensus_[r]];
+                if (hit.residue[r] < 0 || sequence[hit.residue[r]] != triad[r]) hit.conserved = false;
+            }
+        }
+    });
+
+    size_t conserved = 0;
+    for (Hit& hit : hits_) {
+        const auto found = component_of_.find(unknown_[hit.sequence].id);
+        if (found != component_of_.end()) hit.component = found->second;
+        if (hit.conserved) ++conserved;
+    }
+    cout << "ɸɣ" << conserved << "/" << hits_.size() << " обصĴ߻\n";
+}
+
+void TriadScreener::export_summary(const string& output_path) const {
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    outfile << "Protein_ID\tSer_Position\tHis_Position\tAsp_Position\tConserved_Triad_Present"
+        "\tComponent\tSer_Residue\tHis_Residue\tAsp_Residue\n";
+    for (const Hit& hit : hits_) {
+        const string& sequence = unknown_[hit.sequence].sequence;
+        outfile << unknown_[hit.sequence].id << "\t" << consensus_[0] << "\t" << consensus_[1] << "\t"
+            << consensus_[2] << "\t" << (hit.conserved ? "Yes" : "No") << "\t";
+        if (hit.component > 0) outfile << hit.component;
+        else outfile << "NA";
+        // лд "ĸ+λ" S195δ֪Ϊλʱд "-"
+        for (int r = 0; r < 3; ++r) {
+            outfile << "\t";
+            if (hit.residue[r] < 0) outfile << "-";
+            else outfile << sequence[hit.residue[r]] << (hit.residue[r] + 1);
+        }
+        outfile << "\n";
+    }
+
+    outfile.close();
+    cout << "ɸѵ: " << output_path << endl;
+}
+
+void TriadScreener::export_alignments(const string& output_path) const {
+    AsyncFileWriter outfile(output_path);
+    if (!outfile.is_open()) {
+        throw runtime_error("޷ļ: " + output_path);
+    }
+
+    for (size_t k = 0; k < known_.size(); ++k) {
+        outfile << ">" << known_[k].id << "\n" << reference_[k] << "\n";
+    }
+    for (const Hit& hit : hits_) {
+        outfile << ">" << unknown_[hit.sequence].id << "\n" << hit.aligned << "\n";
+    }
+
+    outfile.close();
+    cout << "ȶԽѵ: " << output_path << endl;
+}
+
+#endif // LSPQ_TRIAD_SCREENING_HPP
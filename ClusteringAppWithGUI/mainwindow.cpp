@@ -6,6 +6,16 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include <QDir>
+#include <QTextDocument>
+
+#include "resultsbrowser.h"
+
+namespace {
+    // 日志最多保留的行数，超出后自动丢弃最早的行
+    const int kMaxLogLines = 5000;
+    // 后端输出合并写入日志的间隔（毫秒）
+    const int kLogFlushIntervalMs = 100;
+}
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -23,6 +33,12 @@ MainWindow::MainWindow(QWidget* parent)
 
     connect(backendProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &MainWindow::on_processFinished);
 
+    // 日志限制行数并合并刷新
+    ui->logTextEdit->document()->setMaximumBlockCount(kMaxLogLines);
+    logFlushTimer = new QTimer(this);
+    logFlushTimer->setSingleShot(true);
+    logFlushTimer->setInterval(kLogFlushIntervalMs);
+    connect(logFlushTimer, &QTimer::timeout, this, &MainWindow::flushLog);
 
     // 设置默认参数值
     ui->smallThresholdEdit->setText("0.5");
@@ -185,7 +201,29 @@ void MainWindow::on_runAnalysisButton_clicked()
 void MainWindow::on_processReadyRead()
 {
     QByteArray output = backendProcess->readAllStandardOutput();
-    QString text = QString::fromLocal8Bit(output);
+    pendingLog += QString::fromLocal8Bit(output);
+
+    if (!pendingLog.isEmpty() && !logFlushTimer->isActive()) {
+        logFlushTimer->start();
+    }
+}
+
+void MainWindow::flushLog()
+{
+    // 只写入完整的行，不完整的行留到下一次；进程结束时全部写入
+    qsizetype end = pendingLog.lastIndexOf('\n');
+    if (backendProcess->state() == QProcess::NotRunning) {
+        end = pendingLog.size();
+    }
+    if (end < 0) {
+        return;
+    }
+
+    QString text = pendingLog.left(end);
+    pendingLog.remove(0, end + 1);
+    while (text.endsWith('\n') || text.endsWith('\r')) {
+        text.chop(1);
+    }
 
     if (!text.isEmpty()) {
         ui->logTextEdit->append(text);
@@ -200,6 +238,11 @@ void MainWindow::on_processFinished(int exitCode, QProcess::ExitStatus exitStatu
 {
     //Q_UNUSED(exitStatus)
 
+    // 先写入尚未刷新的输出
+    logFlushTimer->stop();
+    pendingLog += QString::fromLocal8Bit(backendProcess->readAllStandardOutput());
+    flushLog();
+
         // 更新UI状态
         ui->progressBar->setVisible(false);
     ui->runAnalysisButton->setEnabled(true);
@@ -212,7 +255,7 @@ void MainWindow::on_processFinished(int exitCode, QProcess::ExitStatus exitStatu
         QMessageBox::information(this, QStringLiteral("完成"),        
             "聚类分析已完成！\n\n"
             "结果文件已保存到:\n" + ui->outputDirEdit->text() + "\n\n"       
-            "点击\"查看结果\"按钮打开输出目录。");
+            "点击\"查看结果\"按钮浏览结果。");
         //QMessageBox::information(this, "title", "completed");
 
 
@@ -234,7 +277,8 @@ void MainWindow::on_processFinished(int exitCode, QProcess::ExitStatus exitStatu
 
 void MainWindow::on_viewResultsButton_clicked()
 {
-    QString outputDir = ui->outputDirEdit->text();
-    QUrl url = QUrl::fromLocalFile(outputDir);
-    QDesktopServices::openUrl(url);
+    // 在程序内浏览结果；大文件按需读取，不会卡住界面。浏览窗口中也可以打开输出目录
+    ResultsBrowser* browser = new ResultsBrowser(ui->outputDirEdit->text(), this);
+    browser->setAttribute(Qt::WA_DeleteOnClose);
+    browser->show();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <QMainWindow>
 #include <QProcess>
+#include <QTimer>
 
 // ǰҪGraph.hpp
 QT_BEGIN_NAMESPACE
@@ -35,10 +36,17 @@ private slots:
     // 鿴
     void on_viewResultsButton_clicked();
 
+    // ѻĺһд־
+    void flushLog();
+
 private:
     Ui::MainWindow* ui;
     QProcess* backendProcess;
 
+    // Ȼ棬ɶʱϲд룬ÿ readyRead ˢı
+    QTimer* logFlushTimer;
+    QString pendingLog;
+
     // ߺ
     bool validateInputs();
     void updateRunButtonState();
@@ -0,0 +1,551 @@
+#include "resultsbrowser.h"
+#include "ui_resultsbrowser.h"
+
+#include <QApplication>
+#include <QDesktopServices>
+#include <QUrl>
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+namespace {
+
+// 从 pos 开始的一行的结束位置（换行符的位置，最后一行没有换行时为 size）
+qint64 lineEnd(const char* data, qint64 size, qint64 pos)
+{
+    const void* hit = memchr(data + pos, '\n', static_cast<size_t>(size - pos));
+    return hit ? static_cast<const char*>(hit) - data : size;
+}
+
+// 去掉行尾的 \r（Windows 下导出的文件）
+qint64 trimCarriageReturn(const char* data, qint64 begin, qint64 end)
+{
+    return (end > begin && data[end - 1] == '\r') ? end - 1 : end;
+}
+
+// 分组标题形如 "Component 3 (Nodes: 12):"、"Community 5 (Component: 2, Nodes: 40):"、
+// "Component 3 Adjacency Matrix (Nodes: 12):"，取出节点数
+bool parseGroupHeader(const char* line, qint64 length, qint64* nodes)
+{
+    if (length < 3 || line[length - 1] != ':' || line[length - 2] != ')') return false;
+    static const char kNodes[] = "Nodes: ";
+    const char* found = std::search(line, line + length, kNodes, kNodes + sizeof(kNodes) - 1);
+    if (found == line + length) return false;
+    qint64 value = 0;
+    const char* p = found + sizeof(kNodes) - 1;
+    if (p >= line + length || *p < '0' || *p > '9') return false;
+    for (; p < line + length && *p >= '0' && *p <= '9'; ++p) value = value * 10 + (*p - '0');
+    *nodes = value;
+    return true;
+}
+
+// 扫描分组文件：每个分组由标题行开始，到空行结束。
+// onGroup(标题起点, 标题终点, 节点数, 节点行起点, 节点行终点)
+template <typename F>
+void scanGroups(const char* data, qint64 size, F onGroup)
+{
+    qint64 pos = 0;
+    qint64 titleBegin = -1, titleEnd = 0, nodes = 0, begin = 0, end = 0;
+    while (pos < size) {
+        const qint64 next = lineEnd(data, size, pos);
+        const qint64 stop = trimCarriageReturn(data, pos, next);
+        qint64 headerNodes = 0;
+        if (parseGroupHeader(data + pos, stop - pos, &headerNodes)) {
+            if (titleBegin >= 0) onGroup(titleBegin, titleEnd, nodes, begin, end);
+            titleBegin = pos;
+            titleEnd = stop - 1;
+            nodes = headerNodes;
+            begin = end = std::min(next + 1, size);
+        }
+        else if (stop == pos) {
+            if (titleBegin >= 0) onGroup(titleBegin, titleEnd, nodes, begin, end);
+            titleBegin = -1;
+        }
+        else if (titleBegin >= 0) {
+            end = next;
+        }
+        pos = next + 1;
+    }
+    if (titleBegin >= 0) onGroup(titleBegin, titleEnd, nodes, begin, end);
+}
+
+// 在 [begin, end) 中查找 needle
+bool containsBytes(const char* data, qint64 begin, qint64 end, const QByteArray& needle)
+{
+    std::boyer_moore_horspool_searcher<const char*> searcher(needle.constData(), needle.constData() + needle.size());
+    return std::search(data + begin, data + end, searcher) != data + end;
+}
+
+} // namespace
+
+/**************** MappedFile ****************/
+
+bool MappedFile::open(const QString& path)
+{
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    length = file.size();
+    if (length > 0) {
+        mappedBytes = file.map(0, length);
+        if (!mappedBytes) {
+            file.close();
+            length = 0;
+            return false;
+        }
+    }
+    opened = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mappedBytes) file.unmap(mappedBytes);
+    mappedBytes = nullptr;
+    length = 0;
+    opened = false;
+    if (file.isOpen()) file.close();
+}
+
+/**************** GroupFileModel ****************/
+
+GroupFileModel::GroupFileModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+bool GroupFileModel::load(const QString& path, QString* error)
+{
+    beginResetModel();
+    groups.clear();
+    visible.clear();
+    if (!mapped.open(path)) {
+        if (error) *error = mapped.errorString();
+        endResetModel();
+        return false;
+    }
+
+    const char* data = mapped.data();
+    scanGroups(data, mapped.size(), [&](qint64 titleBegin, qint64 titleEnd, qint64 nodes, qint64 begin, qint64 end) {
+        Group group;
+        group.title = QByteArray(data + titleBegin, static_cast<int>(titleEnd - titleBegin));
+        group.number = static_cast<int>(groups.size()) + 1;
+        group.nodes = nodes;
+        group.begin = begin;
+        group.end = end;
+        groups.push_back(group);
+    });
+
+    visible.resize(groups.size());
+    for (int i = 0; i < visible.size(); ++i) visible[i] = i;
+    applySort();
+    endResetModel();
+    return true;
+}
+
+const GroupFileModel::Group* GroupFileModel::groupAt(int row) const
+{
+    if (row < 0 || row >= visible.size()) return nullptr;
+    return &groups[visible[row]];
+}
+
+QStringList GroupFileModel::nodesOf(const Group& group, int limit) const
+{
+    QStringList nodes;
+    const char* data = mapped.data();
+    qint64 pos = group.begin;
+    while (pos < group.end && nodes.size() < limit) {
+        const qint64 next = lineEnd(data, group.end, pos);
+        const qint64 stop = trimCarriageReturn(data, pos, next);
+        nodes << QString::fromUtf8(data + pos, static_cast<int>(stop - pos));
+        pos = next + 1;
+    }
+    return nodes;
+}
+
+// 搜索直接在映射的字节上进行，不把节点ID转成 QString
+void GroupFileModel::setFilterText(const QString& text)
+{
+    beginResetModel();
+    visible.clear();
+    const QByteArray needle = text.trimmed().toUtf8();
+    const char* data = mapped.data();
+    for (int i = 0; i < groups.size(); ++i) {
+        const Group& group = groups[i];
+        if (needle.isEmpty() || group.title.contains(needle) ||
+            containsBytes(data, group.begin, group.end, needle)) {
+            visible.push_back(i);
+        }
+    }
+    applySort();
+    endResetModel();
+}
+
+int GroupFileModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(visible.size());
+}
+
+int GroupFileModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : 3;
+}
+
+QVariant GroupFileModel::data(const QModelIndex& index, int role) const
+{
+    const Group* group = groupAt(index.row());
+    if (!group) return QVariant();
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case 0:
+            return QString::fromUtf8(group->title);
+        case 1:
+            return group->nodes;
+        case 2: {
+            // 节点预览只取前几个，显示时才从映射中读取
+            const int kPreview = 5;
+            QString preview = nodesOf(*group, kPreview).join(QStringLiteral(", "));
+            if (group->nodes > kPreview) preview += QStringLiteral(", ...");
+            return preview;
+        }
+        }
+    }
+    else if (role == Qt::TextAlignmentRole && index.column() == 1) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    return QVariant();
+}
+
+QVariant GroupFileModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QVariant();
+    switch (section) {
+    case 0: return QStringLiteral("分组");
+    case 1: return QStringLiteral("节点数");
+    case 2: return QStringLiteral("节点");
+    }
+    return QVariant();
+}
+
+void GroupFileModel::sort(int column, Qt::SortOrder order)
+{
+    beginResetModel();
+    sortColumn = column;
+    sortOrder = order;
+    applySort();
+    endResetModel();
+}
+
+// 按节点数排序时节点数相同的分组保持文件中的顺序；其它列按文件顺序
+void GroupFileModel::applySort()
+{
+    const bool bySize = sortColumn == 1;
+    const bool descending = sortOrder == Qt::DescendingOrder;
+    std::stable_sort(visible.begin(), visible.end(), [&](int a, int b) {
+        const qint64 ka = bySize ? groups[a].nodes : groups[a].number;
+        const qint64 kb = bySize ? groups[b].nodes : groups[b].number;
+        if (ka == kb) return false;
+        return descending ? ka > kb : ka < kb;
+    });
+}
+
+/**************** EdgeListModel ****************/
+
+EdgeListModel::EdgeListModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+bool EdgeListModel::load(const QString& path, QString* error)
+{
+    beginResetModel();
+    header.clear();
+    checkpoints.clear();
+    matches.clear();
+    lineCount = 0;
+    filtered = false;
+    cachedBlock = -1;
+    if (!mapped.open(path)) {
+        if (error) *error = mapped.errorString();
+        endResetModel();
+        return false;
+    }
+
+    const char* data = mapped.data();
+    const qint64 size = mapped.size();
+    qint64 pos = 0;
+    if (size > 0) {
+        const qint64 next = lineEnd(data, size, 0);
+        header = QByteArray(data, static_cast<int>(trimCarriageReturn(data, 0, next))).split('\t');
+        pos = next + 1;
+    }
+    while (pos < size) {
+        const qint64 next = lineEnd(data, size, pos);
+        if (trimCarriageReturn(data, pos, next) > pos) {
+            if (lineCount % kCheckpointLines == 0) checkpoints.push_back(pos);
+            ++lineCount;
+        }
+        pos = next + 1;
+    }
+    endResetModel();
+    return true;
+}
+
+qint64 EdgeListModel::lineOffset(qint64 line) const
+{
+    const qint64 block = line / kCheckpointLines;
+    if (block != cachedBlock) {
+        cachedOffsets.clear();
+        const char* data = mapped.data();
+        const qint64 size = mapped.size();
+        qint64 pos = checkpoints[static_cast<int>(block)];
+        while (pos < size && cachedOffsets.size() < kCheckpointLines) {
+            const qint64 next = lineEnd(data, size, pos);
+            if (trimCarriageReturn(data, pos, next) > pos) cachedOffsets.push_back(pos);
+            pos = next + 1;
+        }
+        cachedBlock = block;
+    }
+    return cachedOffsets[static_cast<int>(line % kCheckpointLines)];
+}
+
+QList<QByteArray> EdgeListModel::fieldsAt(qint64 offset) const
+{
+    const char* data = mapped.data();
+    const qint64 next = lineEnd(data, mapped.size(), offset);
+    const qint64 stop = trimCarriageReturn(data, offset, next);
+    return QByteArray(data + offset, static_cast<int>(stop - offset)).split('\t');
+}
+
+// 在整个映射上逐次查找关键字，每个命中回退到行首记录一次，然后跳到行尾继续
+void EdgeListModel::setFilterText(const QString& text)
+{
+    beginResetModel();
+    matches.clear();
+    const QByteArray needle = text.trimmed().toUtf8();
+    filtered = !needle.isEmpty();
+    if (filtered && !checkpoints.isEmpty()) {
+        const char* data = mapped.data();
+        const qint64 size = mapped.size();
+        const qint64 first = checkpoints.front();
+        std::boyer_moore_horspool_searcher<const char*> searcher(needle.constData(), needle.constData() + needle.size());
+        const char* cursor = data + first;
+        while (true) {
+            const char* hit = std::search(cursor, data + size, searcher);
+            if (hit == data + size) break;
+            qint64 start = hit - data;
+            while (start > first && data[start - 1] != '\n') --start;
+            matches.push_back(start);
+            cursor = data + std::min(lineEnd(data, size, hit - data) + 1, size);
+        }
+    }
+    endResetModel();
+}
+
+int EdgeListModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return static_cast<int>(filtered ? matches.size() : lineCount);
+}
+
+int EdgeListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(header.size());
+}
+
+QVariant EdgeListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+    if (role == Qt::DisplayRole) {
+        const qint64 offset = filtered ? matches[index.row()] : lineOffset(index.row());
+        const QList<QByteArray> fields = fieldsAt(offset);
+        if (index.column() < fields.size()) return QString::fromUtf8(fields[index.column()]);
+    }
+    else if (role == Qt::TextAlignmentRole && index.column() == header.size() - 1) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    return QVariant();
+}
+
+QVariant EdgeListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal || section >= header.size()) return QVariant();
+    return QString::fromUtf8(header[section]);
+}
+
+/**************** ResultsBrowser ****************/
+
+ResultsBrowser::ResultsBrowser(const QString& outputDir, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::ResultsBrowser)
+    , outputDir(outputDir)
+{
+    ui->setupUi(this);
+    setWindowTitle(QStringLiteral("结果浏览 - ") + QDir::toNativeSeparators(outputDir));
+
+    groupModel = new GroupFileModel(this);
+    edgeModel = new EdgeListModel(this);
+
+    // 固定行高，表格只为可见行取数据
+    ui->resultsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->resultsTable->verticalHeader()->setVisible(false);
+    ui->resultsTable->horizontalHeader()->setStretchLastSection(true);
+
+    // 清空搜索框时恢复全部结果
+    connect(ui->searchEdit, &QLineEdit::textChanged, this, [this](const QString& text) {
+        if (text.isEmpty()) on_searchEdit_returnPressed();
+    });
+
+    // 列出输出目录中存在的结果文件；添加第一项时会触发加载
+    const QStringList candidates = {
+        QStringLiteral("all_components.txt"),
+        QStringLiteral("all_communities.txt"),
+        QStringLiteral("mcl_clusters.txt"),
+        QStringLiteral("network_for_cytoscape.txt")
+    };
+    for (const QString& name : candidates) {
+        if (QFileInfo::exists(QDir(outputDir).filePath(name))) {
+            ui->fileCombo->addItem(name, name);
+        }
+    }
+    if (ui->fileCombo->count() == 0) {
+        ui->statusLabel->setText(QStringLiteral("输出目录中没有可浏览的结果文件"));
+    }
+}
+
+ResultsBrowser::~ResultsBrowser()
+{
+    delete ui;
+}
+
+void ResultsBrowser::on_fileCombo_currentIndexChanged(int index)
+{
+    if (index < 0) return;
+    loadFile(ui->fileCombo->itemData(index).toString());
+}
+
+void ResultsBrowser::loadFile(const QString& fileName)
+{
+    const bool edges = fileName == QStringLiteral("network_for_cytoscape.txt");
+    const QString path = QDir(outputDir).filePath(fileName);
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    const bool ok = edges ? edgeModel->load(path, &error) : groupModel->load(path, &error);
+    const qint64 elapsed = timer.elapsed();
+    QApplication::restoreOverrideCursor();
+
+    // 三个分组文件共用 groupModel，模型未变时 setModel 直接返回，选择模型和连接都保持不变。
+    // 真正更换模型时旧的选择模型不会自动释放，连同其上的连接一起删除，再连接新的选择模型
+    QAbstractItemModel* model = edges ? static_cast<QAbstractItemModel*>(edgeModel) : groupModel;
+    if (ui->resultsTable->model() != model) {
+        QItemSelectionModel* oldSelection = ui->resultsTable->selectionModel();
+        ui->resultsTable->setModel(model);
+        delete oldSelection;
+        connect(ui->resultsTable->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &ResultsBrowser::showSelectedGroup);
+    }
+
+    // 边列表不支持排序；分组默认按文件顺序
+    ui->resultsTable->setSortingEnabled(false);
+    if (!edges) {
+        ui->resultsTable->horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
+        ui->resultsTable->setSortingEnabled(true);
+    }
+
+    ui->searchEdit->blockSignals(true);
+    ui->searchEdit->clear();
+    ui->searchEdit->blockSignals(false);
+    ui->detailView->clear();
+
+    if (!ok) {
+        ui->statusLabel->setText(QStringLiteral("无法打开 ") + fileName + QStringLiteral(": ") + error);
+        return;
+    }
+    updateStatus();
+    ui->statusLabel->setText(ui->statusLabel->text() +
+        QStringLiteral("，索引用时 %1 ms").arg(elapsed));
+}
+
+void ResultsBrowser::on_searchEdit_returnPressed()
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    if (ui->resultsTable->model() == edgeModel) edgeModel->setFilterText(ui->searchEdit->text());
+    else groupModel->setFilterText(ui->searchEdit->text());
+    QApplication::restoreOverrideCursor();
+    ui->detailView->clear();
+    updateStatus();
+}
+
+void ResultsBrowser::on_openDirButton_clicked()
+{
+    QDesktopServices::openUrl(QUrl::fromLocalFile(outputDir));
+}
+
+void ResultsBrowser::updateStatus()
+{
+    if (ui->resultsTable->model() == edgeModel) {
+        ui->statusLabel->setText(QStringLiteral("共 %1 条边，显示 %2 条")
+            .arg(edgeModel->totalEdges()).arg(edgeModel->rowCount()));
+    }
+    else {
+        ui->statusLabel->setText(QStringLiteral("共 %1 个分组，显示 %2 个")
+            .arg(groupModel->totalGroups()).arg(groupModel->rowCount()));
+    }
+}
+
+// 邻接矩阵文件与 all_components.txt 的分支一一对应，第一次查看时建立偏移索引
+void ResultsBrowser::indexMatrixFile()
+{
+    if (matrixIndexed) return;
+    matrixIndexed = true;
+    if (!matrixFile.open(QDir(outputDir).filePath(QStringLiteral("all_component_adjacency_matrices.txt")))) return;
+    scanGroups(matrixFile.data(), matrixFile.size(), [&](qint64, qint64, qint64, qint64 begin, qint64 end) {
+        matrixRanges.push_back(qMakePair(begin, end));
+    });
+}
+
+void ResultsBrowser::showSelectedGroup()
+{
+    if (ui->resultsTable->model() != groupModel) return;
+    const GroupFileModel::Group* group = groupModel->groupAt(ui->resultsTable->currentIndex().row());
+    if (!group) {
+        ui->detailView->clear();
+        return;
+    }
+
+    const int kMaxNodes = 10000;
+    const qint64 kMaxMatrixBytes = 2 * 1024 * 1024;
+
+    QString text = QString::fromUtf8(group->title) + QStringLiteral("\n\n");
+    text += groupModel->nodesOf(*group, kMaxNodes).join(QLatin1Char('\n'));
+    if (group->nodes > kMaxNodes) {
+        text += QStringLiteral("\n... 仅显示前 %1 个节点").arg(kMaxNodes);
+    }
+
+    if (ui->fileCombo->currentData().toString() == QStringLiteral("all_components.txt")) {
+        indexMatrixFile();
+        const int k = group->number - 1;
+        if (k < matrixRanges.size()) {
+            const qint64 bytes = matrixRanges[k].second - matrixRanges[k].first;
+            if (bytes <= kMaxMatrixBytes) {
+                text += QStringLiteral("\n\n邻接矩阵:\n") +
+                    QString::fromUtf8(matrixFile.data() + matrixRanges[k].first, static_cast<int>(bytes));
+            }
+            else {
+                text += QStringLiteral("\n\n邻接矩阵 %1 MB，过大不在此显示，请在 all_component_adjacency_matrices.txt 中查看")
+                    .arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+            }
+        }
+    }
+    ui->detailView->setPlainText(text);
+}
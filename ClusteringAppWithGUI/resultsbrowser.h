@@ -0,0 +1,147 @@
+
+#ifndef RESULTSBROWSER_H
+#define RESULTSBROWSER_H
+
+#include <QDialog>
+#include <QAbstractTableModel>
+#include <QFile>
+#include <QVector>
+#include <QByteArray>
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+namespace Ui {
+    class ResultsBrowser;
+}
+QT_END_NAMESPACE
+
+// ֻӳһļļڴ棬ɲϵͳҳ롣
+class MappedFile
+{
+public:
+    bool open(const QString& path);
+    void close();
+
+    const char* data() const { return reinterpret_cast<const char*>(mappedBytes); }
+    qint64 size() const { return length; }
+    bool isOpen() const { return opened; }
+    QString errorString() const { return file.errorString(); }
+
+private:
+    QFile file;
+    uchar* mappedBytes = nullptr;   // ļӳ䣬Ϊ
+    qint64 length = 0;
+    bool opened = false;
+};
+
+// ļall_components.txtall_communities.txtmcl_clusters.txtıģ͡
+// ʱɨһ飬ֻÿıֽڷΧڵԤҪʾʱŴӳȡ
+// ֻıɼеУƽڵݡ
+class GroupFileModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    struct Group {
+        QByteArray title;   // ȥβðţ "Component 3 (Nodes: 12)"
+        int number = 0;     // ļе˳򣬴 1 ʼ
+        qint64 nodes = 0;
+        qint64 begin = 0;   // һڵеƫ
+        qint64 end = 0;     // һڵ֮ƫ
+    };
+
+    explicit GroupFileModel(QObject* parent = nullptr);
+
+    bool load(const QString& path, QString* error);
+    const Group* groupAt(int row) const;
+    // ڵĽڵ㣬ȡ limit 
+    QStringList nodesOf(const Group& group, int limit) const;
+    // ֻڵIDа text ķ飻text Ϊʱָȫ
+    void setFilterText(const QString& text);
+    int totalGroups() const { return static_cast<int>(groups.size()); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    MappedFile mapped;
+    QVector<Group> groups;
+    QVector<int> visible;   // ɼ -> groups ±
+    int sortColumn = 0;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+
+    void applySort();
+};
+
+// Cytoscape бnetwork_for_cytoscape.txtıģ͡
+// ÿ 256 мһƫƣʾĳʱļңһƫƣ
+// ֻռ 8 ֽ / 256 УʱҲֻɼļʮС
+class EdgeListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit EdgeListModel(QObject* parent = nullptr);
+
+    bool load(const QString& path, QString* error);
+    void setFilterText(const QString& text);
+    qint64 totalEdges() const { return lineCount; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    static const int kCheckpointLines = 256;
+
+    MappedFile mapped;
+    QList<QByteArray> header;
+    QVector<qint64> checkpoints;   //  k*256 еʼƫ
+    qint64 lineCount = 0;
+    bool filtered = false;
+    QVector<qint64> matches;       // ƥеʼƫ
+
+    // ʵһƫƻ
+    mutable qint64 cachedBlock = -1;
+    mutable QVector<qint64> cachedOffsets;
+
+    qint64 lineOffset(qint64 line) const;
+    QList<QByteArray> fieldsAt(qint64 offset) const;
+};
+
+// ڣΪߵıҲΪѡĽڵڽӾ
+class ResultsBrowser : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ResultsBrowser(const QString& outputDir, QWidget* parent = nullptr);
+    ~ResultsBrowser();
+
+private slots:
+    void on_fileCombo_currentIndexChanged(int index);
+    void on_searchEdit_returnPressed();
+    void on_openDirButton_clicked();
+    void showSelectedGroup();
+
+private:
+    Ui::ResultsBrowser* ui;
+    QString outputDir;
+    GroupFileModel* groupModel;
+    EdgeListModel* edgeModel;
+
+    // ڽӾļ齨ƫһβ鿴ʱ
+    MappedFile matrixFile;
+    QVector<QPair<qint64, qint64>> matrixRanges;
+    bool matrixIndexed = false;
+
+    void loadFile(const QString& fileName);
+    void indexMatrixFile();
+    void updateStatus();
+};
+
+#endif // RESULTSBROWSER_H